@@ -0,0 +1,425 @@
+//! Server side replication of one radar's displayable contacts to the players crewing its vehicle.
+//! Only deltas are sent: new contacts, removed contacts and contacts whose quantized azimuth, elevation or range bucket
+//! moved past the thresholds. Every update is two ints:
+//!
+//!     word0 = trackId << 16 | azimuth (0-360 deg in 16 bits)
+//!     word1 = elevation (-90-90 deg in 16 bits) << 16 | range bucket
+//!
+//! Each client has a byte budget refilled at the configured rate. When the budget does not cover every pending update,
+//! removals go first and the rest are ordered by range a few seconds ahead, so near and fast closing contacts win.
+//! Anything left over is still pending next round since the sent state is only advanced for what was sent.
+class AG0_RadarContactReplicator
+{
+    protected AG0_RadarRecieverTransmitterComponent m_Radar;
+    protected ref map<int, ref AG0_RadarReplicationClient> m_mClients = new map<int, ref AG0_RadarReplicationClient>();
+    protected float m_fLastSendTime = -1;
+    protected int m_iGeneration;
+
+    // Quantized displayable contacts of the current round, parallel arrays
+    protected ref array<int> m_aTrackIds = {};
+    protected ref array<int> m_aWords0 = {};
+    protected ref array<int> m_aWords1 = {};
+    protected ref array<float> m_aRanges = {};
+
+    // Scratch for one client send
+    protected ref array<int> m_aCandidates = {};
+    protected ref array<float> m_aScores = {};
+    protected ref array<int> m_aUpdates = {};
+    protected ref array<int> m_aRemovals = {};
+    protected ref array<int> m_aCrew = {};
+    protected ref array<BaseCompartmentSlot> m_aCompartments;  // Every seat of the radar's vehicle, collected on first use
+
+    static const int MESSAGE_OVERHEAD_BYTES = 16;
+    static const int UPDATE_BYTES = 8;
+    static const int REMOVAL_BYTES = 4;
+    static const float PRIORITY_LOOKAHEAD = 5.0;   // Seconds of closure taken into account when ordering updates
+    static const float MAX_BURST = 1.0;            // Seconds of budget a client may bank
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarContactReplicator(notnull AG0_RadarRecieverTransmitterComponent radar)
+    {
+        m_Radar = radar;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Paced by the radar at its replication interval. The radar's displayable contacts are only read once crew were found,
+    //! so a radar showing the network picture only builds its view of it when someone is crewing it.
+    void Update(float currentTime)
+    {
+        float elapsed = MAX_BURST;
+        if (m_fLastSendTime >= 0)
+            elapsed = Math.Min(currentTime - m_fLastSendTime, MAX_BURST);
+        m_fLastSendTime = currentTime;
+
+        FindCrewPlayers(m_aCrew);
+        if (m_aCrew.IsEmpty())
+        {
+            m_mClients.Clear();
+            return;
+        }
+
+        RplComponent rpl = RplComponent.Cast(m_Radar.GetOwner().FindComponent(RplComponent));
+        if (!rpl)
+            return;
+
+        QuantizeContacts(m_Radar.GetDisplayableContacts());
+        m_iGeneration++;
+
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        float bytesPerSecond = m_Radar.GetReplicationBytesPerSecond();
+
+        foreach (int playerId : m_aCrew)
+        {
+            SCR_PlayerController controller = SCR_PlayerController.Cast(playerManager.GetPlayerController(playerId));
+            if (!controller)
+                continue;
+
+            AG0_RadarReplicationClient client = m_mClients.Get(playerId);
+            if (!client)
+            {
+                client = new AG0_RadarReplicationClient();
+                m_mClients.Insert(playerId, client);
+            }
+
+            client.m_iGeneration = m_iGeneration;
+            client.m_fBudget = Math.Min(client.m_fBudget + bytesPerSecond * elapsed, bytesPerSecond * MAX_BURST);
+
+            SendDelta(currentTime, controller, rpl.Id(), client);
+        }
+
+        // Players that left the crew start from a reset when they come back
+        for (int i = m_mClients.Count() - 1; i >= 0; i--)
+        {
+            if (m_mClients.GetElement(i).m_iGeneration != m_iGeneration)
+                m_mClients.RemoveElement(i);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! True once no client holds a track it was not yet told to remove
+    bool IsSettled()
+    {
+        for (int i = 0; i < m_mClients.Count(); i++)
+        {
+            if (m_mClients.GetElement(i).m_mSent.Count() > 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Players seated anywhere in the radar's vehicle, excluding the local player of a listen server who reads the contacts directly
+    protected void FindCrewPlayers(notnull array<int> outPlayerIds)
+    {
+        outPlayerIds.Clear();
+
+        if (!m_aCompartments)
+        {
+            m_aCompartments = {};
+            CollectCompartments(m_Radar.GetOwner().GetRootParent());
+        }
+
+        PlayerManager playerManager = GetGame().GetPlayerManager();
+        PlayerController localController = GetGame().GetPlayerController();
+        int localPlayerId;
+        if (localController)
+            localPlayerId = localController.GetPlayerId();
+
+        foreach (BaseCompartmentSlot compartment : m_aCompartments)
+        {
+            if (!compartment)
+                continue;
+
+            IEntity occupant = compartment.GetOccupant();
+            if (!occupant)
+                continue;
+
+            int playerId = playerManager.GetPlayerIdFromControlledEntity(occupant);
+            if (playerId > 0 && playerId != localPlayerId && !outPlayerIds.Contains(playerId))
+                outPlayerIds.Insert(playerId);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Seats of entity and everything attached to it, such as turrets with their own compartment manager
+    protected void CollectCompartments(IEntity entity)
+    {
+        BaseCompartmentManagerComponent manager = BaseCompartmentManagerComponent.Cast(entity.FindComponent(BaseCompartmentManagerComponent));
+        if (manager)
+        {
+            array<BaseCompartmentSlot> compartments = {};
+            manager.GetCompartments(compartments);
+            m_aCompartments.InsertAll(compartments);
+        }
+
+        IEntity child = entity.GetChildren();
+        while (child)
+        {
+            CollectCompartments(child);
+            child = child.GetSibling();
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void QuantizeContacts(notnull array<ref RadarContact> contacts)
+    {
+        m_aTrackIds.Clear();
+        m_aWords0.Clear();
+        m_aWords1.Clear();
+        m_aRanges.Clear();
+
+        float invRangeBucket = 1 / Math.Max(m_Radar.GetReplicationRangeBucket(), 0.01);
+
+        foreach (RadarContact contact : contacts)
+        {
+            m_aTrackIds.Insert(contact.m_iTrackId);
+            m_aWords0.Insert(PackWord0(contact.m_iTrackId, contact.GetAzimuth()));
+            m_aWords1.Insert(PackWord1(contact.GetElevation(), contact.GetDistance() * invRangeBucket));
+            m_aRanges.Insert(contact.GetDistance());
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void SendDelta(float currentTime, SCR_PlayerController controller, RplId radarId, AG0_RadarReplicationClient client)
+    {
+        m_aCandidates.Clear();
+        m_aScores.Clear();
+        m_aUpdates.Clear();
+        m_aRemovals.Clear();
+
+        int angleThreshold = m_Radar.GetReplicationAngleThreshold() / 360.0 * 65536;
+        int count = m_aTrackIds.Count();
+        int i;
+
+        for (i = 0; i < count; i++)
+        {
+            AG0_RadarSentContact sent = client.m_mSent.Get(m_aTrackIds[i]);
+            float closingSpeed = 0;
+            if (sent)
+            {
+                sent.m_iGeneration = m_iGeneration;
+                if (!client.m_bNeedsReset && !HasMoved(sent, m_aWords0[i], m_aWords1[i], angleThreshold))
+                    continue;
+
+                float sentAge = currentTime - sent.m_fTime;
+                if (sentAge > 0)
+                    closingSpeed = (sent.m_fRange - m_aRanges[i]) / sentAge;
+            }
+
+            m_aCandidates.Insert(i);
+            m_aScores.Insert(m_aRanges[i] - closingSpeed * PRIORITY_LOOKAHEAD);
+        }
+
+        // Tracks the client holds that are no longer displayable
+        for (i = client.m_mSent.Count() - 1; i >= 0; i--)
+        {
+            if (client.m_mSent.GetElement(i).m_iGeneration != m_iGeneration)
+                m_aRemovals.Insert(client.m_mSent.GetKey(i));
+        }
+
+        if (m_aCandidates.IsEmpty() && m_aRemovals.IsEmpty() && !client.m_bNeedsReset)
+            return;
+
+        int bytes = MESSAGE_OVERHEAD_BYTES + m_aRemovals.Count() * REMOVAL_BYTES;
+        if (bytes > client.m_fBudget)
+            return; // Keep banking until at least the removals fit
+
+        // Cheapest first: pick the best remaining candidate while the budget allows
+        while (!m_aCandidates.IsEmpty() && bytes + UPDATE_BYTES <= client.m_fBudget)
+        {
+            int best = 0;
+            for (int c = 1; c < m_aCandidates.Count(); c++)
+            {
+                if (m_aScores[c] < m_aScores[best])
+                    best = c;
+            }
+
+            int index = m_aCandidates[best];
+            m_aCandidates.Remove(best);
+            m_aScores.Remove(best);
+
+            m_aUpdates.Insert(m_aWords0[index]);
+            m_aUpdates.Insert(m_aWords1[index]);
+            bytes += UPDATE_BYTES;
+
+            AG0_RadarSentContact sentContact = client.m_mSent.Get(m_aTrackIds[index]);
+            if (!sentContact)
+            {
+                sentContact = new AG0_RadarSentContact();
+                client.m_mSent.Insert(m_aTrackIds[index], sentContact);
+            }
+
+            sentContact.m_iWord0 = m_aWords0[index];
+            sentContact.m_iWord1 = m_aWords1[index];
+            sentContact.m_fRange = m_aRanges[index];
+            sentContact.m_fTime = currentTime;
+            sentContact.m_iGeneration = m_iGeneration;
+        }
+
+        foreach (int trackId : m_aRemovals)
+        {
+            client.m_mSent.Remove(trackId);
+        }
+
+        client.m_fBudget -= bytes;
+        controller.AG0_SendRadarContactDelta(radarId, client.m_bNeedsReset, m_aUpdates, m_aRemovals);
+        client.m_bNeedsReset = false;
+
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.CONTACTS, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.CONTACTS, string.Format("Contact delta to player %1: %2 updates, %3 removals, %4 bytes, %5 pending", controller.GetPlayerId(), m_aUpdates.Count() / 2, m_aRemovals.Count(), bytes, m_aCandidates.Count()), LogLevel.SPAM);
+#endif
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected bool HasMoved(AG0_RadarSentContact sent, int word0, int word1, int angleThreshold)
+    {
+        // Range bucket changed
+        if ((sent.m_iWord1 & 0xFFFF) != (word1 & 0xFFFF))
+            return true;
+
+        // Azimuth wraps at 65536
+        int azimuthDelta = Math.AbsInt((sent.m_iWord0 & 0xFFFF) - (word0 & 0xFFFF));
+        if (azimuthDelta > 32768)
+            azimuthDelta = 65536 - azimuthDelta;
+        if (azimuthDelta > angleThreshold)
+            return true;
+
+        // Elevation spans 180 degrees in the same 16 bits
+        int elevationDelta = Math.AbsInt(((sent.m_iWord1 >> 16) & 0xFFFF) - ((word1 >> 16) & 0xFFFF));
+        return elevationDelta > angleThreshold * 2;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static int PackWord0(int trackId, float azimuth)
+    {
+        int azimuth16 = Math.Round(azimuth / 360.0 * 65536);
+        return ((trackId & 0xFFFF) << 16) | (azimuth16 & 0xFFFF);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static int PackWord1(float elevation, float rangeBuckets)
+    {
+        int elevation16 = Math.Round((Math.Clamp(elevation, -90, 90) + 90) / 180.0 * 65535);
+        int range16 = Math.Min(Math.Round(rangeBuckets), 65535);
+        return (elevation16 << 16) | range16;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static int UnpackTrackId(int word0)
+    {
+        return (word0 >> 16) & 0xFFFF;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static float UnpackAzimuth(int word0)
+    {
+        return (word0 & 0xFFFF) / 65536.0 * 360;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static float UnpackElevation(int word1)
+    {
+        return ((word1 >> 16) & 0xFFFF) / 65535.0 * 180 - 90;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static float UnpackRange(int word1, float rangeBucket)
+    {
+        return (word1 & 0xFFFF) * rangeBucket;
+    }
+}
+
+//! What one client was last sent, per track
+class AG0_RadarReplicationClient
+{
+    ref map<int, ref AG0_RadarSentContact> m_mSent = new map<int, ref AG0_RadarSentContact>();
+    float m_fBudget;
+    int m_iGeneration;
+    bool m_bNeedsReset = true;
+}
+
+class AG0_RadarSentContact
+{
+    int m_iWord0;
+    int m_iWord1;
+    float m_fRange;
+    float m_fTime;
+    int m_iGeneration;  // Replicator round the track was last seen displayable
+}
+
+//! Client side mirror of a radar's contacts, built from the deltas the server sends
+class AG0_RadarContactPicture
+{
+    protected ref map<int, ref AG0_RadarReplicatedContact> m_mContacts = new map<int, ref AG0_RadarReplicatedContact>();
+    protected int m_iGeneration;
+
+    //------------------------------------------------------------------------------------------------
+    void ApplyDelta(bool reset, notnull array<int> updates, notnull array<int> removals, float rangeBucket)
+    {
+        m_iGeneration++;
+
+        if (reset)
+            m_mContacts.Clear();
+
+        foreach (int trackId : removals)
+        {
+            m_mContacts.Remove(trackId);
+        }
+
+        float currentTime = System.GetTickCount() / 1000.0;
+        for (int i = 0; i + 1 < updates.Count(); i += 2)
+        {
+            int trackId = AG0_RadarContactReplicator.UnpackTrackId(updates[i]);
+            AG0_RadarReplicatedContact contact = m_mContacts.Get(trackId);
+            if (!contact)
+            {
+                contact = new AG0_RadarReplicatedContact();
+                contact.m_iTrackId = trackId;
+                m_mContacts.Insert(trackId, contact);
+            }
+
+            contact.m_fAzimuth = AG0_RadarContactReplicator.UnpackAzimuth(updates[i]);
+            contact.m_fElevation = AG0_RadarContactReplicator.UnpackElevation(updates[i + 1]);
+            contact.m_fRange = AG0_RadarContactReplicator.UnpackRange(updates[i + 1], rangeBucket);
+            contact.m_fReceivedTime = currentTime;
+            contact.m_iGeneration = m_iGeneration;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetContacts(notnull array<AG0_RadarReplicatedContact> outContacts)
+    {
+        outContacts.Clear();
+        for (int i = 0; i < m_mContacts.Count(); i++)
+        {
+            outContacts.Insert(m_mContacts.GetElement(i));
+        }
+
+        return outContacts.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int Count()
+    {
+        return m_mContacts.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Changes with every applied delta
+    int GetGeneration()
+    {
+        return m_iGeneration;
+    }
+}
+
+class AG0_RadarReplicatedContact
+{
+    int m_iTrackId;
+    float m_fAzimuth;
+    float m_fElevation;
+    float m_fRange;
+    float m_fReceivedTime;
+    int m_iGeneration;      // Picture generation of the delta that last changed the contact
+}
@@ -0,0 +1,94 @@
+//! Immutable copy of a radar's displayable contacts at one point in time.
+//! Records are packed contiguously, RECORD_STRIDE floats each, next to a parallel array of entity IDs. A snapshot is never
+//! modified after it was built; the radar hands out a new one with a higher version once its contacts change, so a consumer
+//! may keep and iterate a snapshot for as long as it likes.
+class AG0_RadarContactSnapshot
+{
+    protected int m_iVersion;
+    protected float m_fTime;
+    protected ref array<EntityID> m_aEntityIds = {};
+    protected ref array<float> m_aRecords = {};
+
+    static const int RECORD_STRIDE = 4;
+    static const int RECORD_AZIMUTH = 0;
+    static const int RECORD_ELEVATION = 1;
+    static const int RECORD_RANGE = 2;
+    static const int RECORD_AGE = 3;       // Seconds since last detection, at snapshot time
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarContactSnapshot(int version, notnull array<ref RadarContact> contacts, float time)
+    {
+        m_iVersion = version;
+        m_fTime = time;
+
+        int count = contacts.Count();
+        m_aEntityIds.Reserve(count);
+        m_aRecords.Resize(count * RECORD_STRIDE);
+
+        int offset;
+        foreach (RadarContact contact : contacts)
+        {
+            IEntity entity = contact.GetEntity();
+            if (entity)
+                m_aEntityIds.Insert(entity.GetID());
+            else
+                m_aEntityIds.Insert(EntityID.INVALID);
+
+            m_aRecords[offset + RECORD_AZIMUTH] = contact.GetAzimuth();
+            m_aRecords[offset + RECORD_ELEVATION] = contact.GetElevation();
+            m_aRecords[offset + RECORD_RANGE] = contact.GetDistance();
+            m_aRecords[offset + RECORD_AGE] = time - contact.GetLastDetectedTime();
+            offset += RECORD_STRIDE;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Increases every time the radar builds a new snapshot
+    int GetVersion()
+    {
+        return m_iVersion;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetTime()
+    {
+        return m_fTime;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int Count()
+    {
+        return m_aEntityIds.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    EntityID GetEntityId(int index)
+    {
+        return m_aEntityIds[index];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetAzimuth(int index)
+    {
+        return m_aRecords[index * RECORD_STRIDE + RECORD_AZIMUTH];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetElevation(int index)
+    {
+        return m_aRecords[index * RECORD_STRIDE + RECORD_ELEVATION];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetRange(int index)
+    {
+        return m_aRecords[index * RECORD_STRIDE + RECORD_RANGE];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Age at currentTime, the snapshot only stores the age when it was taken
+    float GetAge(int index, float currentTime)
+    {
+        return m_aRecords[index * RECORD_STRIDE + RECORD_AGE] + currentTime - m_fTime;
+    }
+}
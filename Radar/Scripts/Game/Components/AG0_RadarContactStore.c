@@ -0,0 +1,236 @@
+//! Contacts of one radar, indexed by entity.
+//! Lookups go through a map; both the contact list and the displayable list are unordered and use swap-removal,
+//! with each contact remembering its own slot, so add, find and remove are all O(1).
+//! Removed contacts go back to a shared free list and are reused for the next new track.
+//!
+//! Contact deadlines (expiry, reveal, refresh) live in a timing wheel of WHEEL_SLOTS buckets, WHEEL_RESOLUTION seconds each,
+//! so maintenance only touches contacts that are actually due. Moving a deadline later is lazy: the contact stays in its
+//! earlier bucket and is simply rescheduled when that bucket comes up. Moving it earlier inserts it again and the old entry
+//! is dropped as stale when reached.
+//!
+//! Every change bumps a generation counter that is also stamped on the changed contact, so readers such as the scope
+//! renderer can skip unchanged frames and unchanged contacts.
+class AG0_RadarContactStore
+{
+    protected ref array<ref RadarContact> m_aContacts = {};
+    protected ref array<ref RadarContact> m_aDisplayable = {};
+    protected ref map<IEntity, RadarContact> m_mByEntity = new map<IEntity, RadarContact>();
+
+    protected ref array<ref array<RadarContact>> m_aWheel = {};
+    protected int m_iWheelTick; // Last tick CollectDue processed
+    protected int m_iNextTrackId;
+    protected int m_iGeneration;
+
+    protected static ref array<ref RadarContact> s_aFreeContacts = {};
+    protected static const int MAX_FREE_CONTACTS = 1024;
+    protected static const float WHEEL_RESOLUTION = 0.1;
+    protected static const int WHEEL_SLOTS = 512;
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarContactStore()
+    {
+        m_aWheel.Resize(WHEEL_SLOTS);
+        m_iWheelTick = Math.Floor(System.GetTickCount() / 1000.0 / WHEEL_RESOLUTION);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    RadarContact Find(IEntity entity)
+    {
+        return m_mByEntity.Get(entity);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    RadarContact Add(IEntity entity, vector position, float azimuth, float elevation)
+    {
+        RadarContact contact;
+        int freeCount = s_aFreeContacts.Count();
+        if (freeCount > 0)
+        {
+            contact = s_aFreeContacts[freeCount - 1];
+            s_aFreeContacts.Remove(freeCount - 1);
+            contact.Reset(entity, position, azimuth, elevation);
+        }
+        else
+        {
+            contact = new RadarContact(entity, position, azimuth, elevation);
+        }
+
+        contact.m_Store = this;
+        contact.m_iStoreIndex = m_aContacts.Insert(contact);
+        contact.m_iWheelTick = -1;
+        contact.m_iTrackId = m_iNextTrackId;
+        m_iNextTrackId = (m_iNextTrackId + 1) & 0xFFFF;
+        m_mByEntity.Insert(entity, contact);
+        MarkChanged(contact);
+        return contact;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Remove(RadarContact contact)
+    {
+        SetDisplayable(contact, false);
+
+        IEntity entity = contact.GetEntity();
+        if (entity)
+            m_mByEntity.Remove(entity);
+        else
+            RemoveDeletedEntityKeys();
+
+        // Hand the contact to the free list before its slot is overwritten, the store array may hold the only reference
+        if (s_aFreeContacts.Count() < MAX_FREE_CONTACTS)
+            s_aFreeContacts.Insert(contact);
+
+        int index = contact.m_iStoreIndex;
+        int last = m_aContacts.Count() - 1;
+        if (index != last)
+        {
+            m_aContacts[index] = m_aContacts[last];
+            m_aContacts[index].m_iStoreIndex = index;
+        }
+
+        m_aContacts.Remove(last);
+        contact.m_Store = null;
+        contact.m_iStoreIndex = -1;
+        contact.m_iWheelTick = -1;
+        m_iGeneration++;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! To be called whenever the contact's detection data changed
+    void MarkChanged(RadarContact contact)
+    {
+        m_iGeneration++;
+        contact.m_iGeneration = m_iGeneration;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetGeneration()
+    {
+        return m_iGeneration;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Makes the contact due no later than time. Deadlines beyond the wheel horizon are clamped, the contact is then
+    //! simply rescheduled when it comes up early.
+    void Schedule(RadarContact contact, float time)
+    {
+        int tick = Math.Ceil(time / WHEEL_RESOLUTION);
+        tick = Math.Max(tick, m_iWheelTick + 1);
+        tick = Math.Min(tick, m_iWheelTick + WHEEL_SLOTS - 1);
+
+        // Already due at or before the requested tick; the later deadline is picked up when it pops
+        if (contact.m_iWheelTick >= 0 && contact.m_iWheelTick <= tick)
+            return;
+
+        int slotIndex = tick % WHEEL_SLOTS;
+        array<RadarContact> slot = m_aWheel[slotIndex];
+        if (!slot)
+        {
+            slot = {};
+            m_aWheel[slotIndex] = slot;
+        }
+
+        slot.Insert(contact);
+        contact.m_iWheelTick = tick;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Moves every contact whose scheduled tick has passed into outDue and unschedules it.
+    //! Callers are expected to Schedule (or Remove) each returned contact again.
+    void CollectDue(float currentTime, notnull array<RadarContact> outDue)
+    {
+        int nowTick = Math.Floor(currentTime / WHEEL_RESOLUTION);
+        if (nowTick <= m_iWheelTick)
+            return;
+
+        // After a long stall every slot is visited once
+        int firstTick = Math.Max(m_iWheelTick + 1, nowTick - WHEEL_SLOTS + 1);
+
+        for (int tick = firstTick; tick <= nowTick; tick++)
+        {
+            int slotIndex = tick % WHEEL_SLOTS;
+            array<RadarContact> slot = m_aWheel[slotIndex];
+            if (!slot || slot.IsEmpty())
+                continue;
+
+            for (int i = slot.Count() - 1; i >= 0; i--)
+            {
+                RadarContact contact = slot[i];
+
+                // Stale entry: contact deleted, removed from the store (and possibly reused by another radar's store),
+                // or rescheduled into another slot
+                if (!contact || contact.m_Store != this || contact.m_iWheelTick < 0 || contact.m_iWheelTick % WHEEL_SLOTS != slotIndex)
+                {
+                    slot.Remove(i);
+                    continue;
+                }
+
+                if (contact.m_iWheelTick > nowTick)
+                    continue;
+
+                contact.m_iWheelTick = -1;
+                outDue.Insert(contact);
+                slot.Remove(i);
+            }
+        }
+
+        m_iWheelTick = nowTick;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void SetDisplayable(RadarContact contact, bool displayable)
+    {
+        if (contact.IsDisplayable() == displayable)
+            return;
+
+        contact.SetDisplayable(displayable);
+        MarkChanged(contact);
+
+        if (displayable)
+        {
+            contact.m_iDisplayIndex = m_aDisplayable.Insert(contact);
+            return;
+        }
+
+        int index = contact.m_iDisplayIndex;
+        int last = m_aDisplayable.Count() - 1;
+        if (index != last)
+        {
+            m_aDisplayable[index] = m_aDisplayable[last];
+            m_aDisplayable[index].m_iDisplayIndex = index;
+        }
+
+        m_aDisplayable.Remove(last);
+        contact.m_iDisplayIndex = -1;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Unordered; iterate backwards when removing while iterating
+    array<ref RadarContact> GetContacts()
+    {
+        return m_aContacts;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    array<ref RadarContact> GetDisplayable()
+    {
+        return m_aDisplayable;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int Count()
+    {
+        return m_aContacts.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Keys of deleted entities can no longer be looked up; only happens when a tracked entity was deleted
+    protected void RemoveDeletedEntityKeys()
+    {
+        for (int i = m_mByEntity.Count() - 1; i >= 0; i--)
+        {
+            if (!m_mByEntity.GetKey(i))
+                m_mByEntity.RemoveElement(i);
+        }
+    }
+}
@@ -0,0 +1,17 @@
+class AG0_RadarCrossSectionComponentClass : ScriptComponentClass
+{
+}
+
+//! Radar cross-section of a vehicle prefab. Only read once per prefab when a vehicle registers with AG0_RadarCoverageSystem,
+//! vehicles without it count as medium.
+class AG0_RadarCrossSectionComponent : ScriptComponent
+{
+    [Attribute("1", UIWidgets.ComboBox, "Radar cross-section class, scales detection strength and with it detection range", "", ParamEnumArray.FromEnum(ERadarCrossSection))]
+    protected ERadarCrossSection m_eCrossSection;
+
+    //------------------------------------------------------------------------------------------------
+    ERadarCrossSection GetCrossSection()
+    {
+        return m_eCrossSection;
+    }
+}
@@ -0,0 +1,178 @@
+//! Terrain horizon profile baked around a radar that does not move.
+//! For every azimuth bin it stores, per range ring, the steepest terrain slope seen from the antenna up to that ring,
+//! so a target can be rejected as terrain masked with a table lookup instead of a trace.
+//! Only terrain is considered; anything the mask lets through still goes through the regular line of sight trace.
+//!
+//! Baking costs bins * range / spacing height queries and is spread over frames by AG0_RadarCoverageSystem through
+//! BakeStep; the mask does not reject anything until every bin is done.
+//! Azimuth bins are laid out over the diamond angle (a monotonic, trig free stand-in for the azimuth, 0-4 clockwise
+//! from +Z), so lookups need no Atan2. Bins are slightly narrower towards the diagonals than along the axes.
+class AG0_RadarHorizonMask
+{
+    protected vector m_vOrigin;
+    protected int m_iAzimuthBins;
+    protected int m_iBakedBins;
+    protected int m_iRings;
+    protected float m_fRingSpacing;
+    protected float m_fInvRingSpacing;
+    protected float m_fBinsPerDiamond;
+
+    // Flat [bin * m_iRings + ring] table of cumulative max slope (height delta / horizontal distance)
+    protected ref array<float> m_aSlopes = {};
+
+    protected static const float TARGET_CLEARANCE = 2.0; // Meters added to the target height so hull tops peeking over a crest are not culled
+    protected static const float INV_SQRT2 = 0.70710678;
+
+    //------------------------------------------------------------------------------------------------
+    //! Discards any previous profile and prepares a bake around origin, carried out by BakeStep
+    void BeginBake(vector origin, float range, int azimuthBins, float ringSpacing)
+    {
+        m_vOrigin = origin;
+        m_iAzimuthBins = Math.Max(azimuthBins, 8);
+        m_iBakedBins = 0;
+        m_fRingSpacing = Math.Max(ringSpacing, 1.0);
+        m_fInvRingSpacing = 1.0 / m_fRingSpacing;
+        m_iRings = Math.Max(Math.Ceil(range * m_fInvRingSpacing), 1);
+        m_fBinsPerDiamond = m_iAzimuthBins / 4.0;
+
+        m_aSlopes.Clear();
+        m_aSlopes.Reserve(m_iAzimuthBins * m_iRings);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Bakes whole bins until maxSamples height queries are used up, at least one bin per call.
+    //! Returns the number of height queries made.
+    int BakeStep(int maxSamples)
+    {
+        BaseWorld world = GetGame().GetWorld();
+        int samples;
+
+        while (m_iBakedBins < m_iAzimuthBins && (samples == 0 || samples + m_iRings <= maxSamples))
+        {
+            vector direction = DiamondToDirection((m_iBakedBins + 0.5) / m_fBinsPerDiamond);
+            float maxSlope = -float.MAX;
+
+            for (int ring = 0; ring < m_iRings; ring++)
+            {
+                float distance = (ring + 1) * m_fRingSpacing;
+                float terrainY = world.GetSurfaceY(m_vOrigin[0] + direction[0] * distance, m_vOrigin[2] + direction[2] * distance);
+                maxSlope = Math.Max(maxSlope, (terrainY - m_vOrigin[1]) / distance);
+                m_aSlopes.Insert(maxSlope);
+            }
+
+            m_iBakedBins++;
+            samples += m_iRings;
+        }
+
+        return samples;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool IsBaked()
+    {
+        return m_iAzimuthBins > 0 && m_iBakedBins == m_iAzimuthBins;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! True while a bake around a point within one ring of radarPos is in progress
+    bool IsBakingFor(vector radarPos)
+    {
+        return m_iBakedBins < m_iAzimuthBins && vector.DistanceSq(radarPos, m_vOrigin) < m_fRingSpacing * m_fRingSpacing;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! True while radarPos is still within one ring of where the mask was baked
+    bool IsValidFor(vector radarPos)
+    {
+        return IsBaked() && vector.DistanceSq(radarPos, m_vOrigin) < m_fRingSpacing * m_fRingSpacing;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! True when terrain between the baked origin and targetPos rises above the line to the target.
+    //! Only rings strictly in front of the target are used, and the lower of the two neighbouring azimuth bins,
+    //! so the test errs on the side of letting the trace decide. No square roots or trig.
+    bool IsBelowHorizon(vector targetPos)
+    {
+        float dx = targetPos[0] - m_vOrigin[0];
+        float dz = targetPos[2] - m_vOrigin[2];
+        float absX = Math.AbsFloat(dx);
+        float absZ = Math.AbsFloat(dz);
+
+        // Octagonal lower bound of the horizontal distance (within 8 percent); a lower ring only makes the test more lenient
+        float distanceBound = Math.Max(Math.Max(absX, absZ), (absX + absZ) * INV_SQRT2);
+        int ring = Math.Floor(distanceBound * m_fInvRingSpacing) - 1;
+        if (ring < 0)
+            return false;
+
+        if (ring >= m_iRings)
+            ring = m_iRings - 1;
+
+        // Bins are sampled at their centers; pick the two centers bracketing the target direction
+        float binPosition = DirectionToDiamond(dx, dz) * m_fBinsPerDiamond - 0.5;
+        int binA = Math.Floor(binPosition);
+        int binB = binA + 1;
+        if (binA < 0)
+            binA += m_iAzimuthBins;
+        if (binB >= m_iAzimuthBins)
+            binB -= m_iAzimuthBins;
+
+        float horizonSlope = Math.Min(m_aSlopes[binA * m_iRings + ring], m_aSlopes[binB * m_iRings + ring]);
+        float height = targetPos[1] + TARGET_CLEARANCE - m_vOrigin[1];
+
+        // height / distance < horizonSlope, compared in squared form
+        if (height >= 0 && horizonSlope <= 0)
+            return false;
+
+        if (height < 0 && horizonSlope >= 0)
+            return true;
+
+        float heightSq = height * height;
+        float horizonSq = horizonSlope * horizonSlope * (dx * dx + dz * dz);
+        if (height >= 0)
+            return heightSq < horizonSq;
+
+        return heightSq > horizonSq;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Diamond angle of a horizontal direction, 0-4 clockwise from +Z; direction must not be zero
+    static float DirectionToDiamond(float dx, float dz)
+    {
+        float absX = Math.AbsFloat(dx);
+        float absZ = Math.AbsFloat(dz);
+        float invSum = 1 / (absX + absZ);
+
+        if (dx >= 0)
+        {
+            if (dz >= 0)
+                return absX * invSum;
+
+            return 1 + absZ * invSum;
+        }
+
+        if (dz < 0)
+            return 2 + absX * invSum;
+
+        return 3 + absZ * invSum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Horizontal unit direction of a diamond angle, inverse of DirectionToDiamond
+    static vector DiamondToDirection(float diamond)
+    {
+        int quadrant = Math.Floor(diamond);
+        float fraction = diamond - quadrant;
+
+        vector direction;
+        switch (quadrant % 4)
+        {
+            case 0: direction = Vector(fraction, 0, 1 - fraction); break;
+            case 1: direction = Vector(1 - fraction, 0, -fraction); break;
+            case 2: direction = Vector(-fraction, 0, fraction - 1); break;
+            default: direction = Vector(fraction - 1, 0, fraction); break;
+        }
+
+        direction.Normalize();
+        return direction;
+    }
+}
@@ -26,6 +26,7 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
     protected bool m_bAutoCalculateThreshold;
 
     protected float m_fEffectiveDetectionThreshold;
+    protected ref array<float> m_aDetectionRangesSq = {};  // Squared distance at which strength drops below the threshold, per ERadarCrossSection
     
     [Attribute("0.5", UIWidgets.EditBox, "Detection threshold (lower values make the radar more sensitive)")]
     protected float m_fDetectionThreshold;
@@ -40,7 +41,94 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
     protected float m_fBaseUpdateInterval;
 	
 	protected float m_fCurrentUpdateInterval;
-
+	protected float m_fNextContactUpdateTime;
+	protected float m_fNextReplicationTime;
+	
+	[Attribute("1000", UIWidgets.EditBox, "Contacts closer than this many meters are refreshed every update interval, further ones proportionally less often")]
+    protected float m_fLODNearRange;
+	
+	[Attribute("8", UIWidgets.EditBox, "Longest interval in seconds between refreshes and re-detections of a contact")]
+    protected float m_fLODMaxInterval;
+	
+	[Attribute("2", UIWidgets.EditBox, "Bearing change in degrees a contact may make between refreshes")]
+    protected float m_fLODAngleStep;
+	
+	[Attribute("100", UIWidgets.EditBox, "Range change in meters a contact may make between refreshes")]
+    protected float m_fLODRangeStep;
+	
+	[Attribute("0", desc: "With an IFF key set, detections only feed the network's shared track picture in AG0_RadarCoverageSystem and the radar keeps no contacts of its own; its scope and crew are shown the network's tracks")]
+    protected bool m_bUseNetworkPicture;
+	
+	protected ref AG0_RadarContactStore m_NetworkContacts;  // Network tracks as seen from this radar, only built once a consumer asks
+	protected int m_iNetworkPictureGeneration = -1;         // Picture generation m_NetworkContacts was synced to
+	protected int m_iNetworkContactsKey = -1;               // IFF key m_NetworkContacts was synced from
+	
+	[Attribute("0", desc: "Run an alpha-beta filter on every contact so its position can be extrapolated between scans")]
+    protected bool m_bTrackFilter;
+	
+	[Attribute("0.5", UIWidgets.EditBox, "Track filter position gain (0 to 1, higher follows measurements more closely)")]
+    protected float m_fTrackAlpha;
+	
+	[Attribute("0.2", UIWidgets.EditBox, "Track filter velocity gain (0 to 1, higher reacts faster to manoeuvres)")]
+    protected float m_fTrackBeta;
+	
+	[Attribute("2.0", UIWidgets.EditBox, "Distance in meters either end of a cached line of sight result may move before it is traced again")]
+    protected float m_fLOSCacheTolerance;
+	
+	[Attribute("5.0", UIWidgets.EditBox, "Maximum age in seconds of a cached line of sight result")]
+    protected float m_fLOSCacheMaxAge;
+	
+	protected ref map<IEntity, ref RadarLOSCacheEntry> m_LOSCache;
+	
+	[Attribute("0", desc: "Radar never moves. A terrain horizon mask is baked when it starts emitting and used to reject terrain masked targets without a trace")]
+    protected bool m_bStaticEmplacement;
+	
+	[Attribute("180", UIWidgets.EditBox, "Number of azimuth bins of the baked horizon mask")]
+    protected int m_iHorizonAzimuthBins;
+	
+	[Attribute("50", UIWidgets.EditBox, "Distance in meters between terrain samples along each horizon mask bin")]
+    protected float m_fHorizonRingSpacing;
+	
+	protected ref AG0_RadarHorizonMask m_HorizonMask;
+	
+	protected ref AG0_RadarScanFrame m_ScanFrame;
+	
+	[Attribute("0", desc: "Search radar with a rotating beam. Each coverage cycle only evaluates the sector the beam passes over, contacts refresh as the beam passes them")]
+    protected bool m_bSweepMode;
+	
+	[Attribute("10", UIWidgets.EditBox, "Beam width in degrees of the sweep")]
+    protected float m_fBeamWidth;
+	
+	[Attribute("36", UIWidgets.EditBox, "Sweep rate in degrees per second; the beam wraps back to the start of the field of view at its end")]
+    protected float m_fSweepRate;
+	
+	protected float m_fSweepPosition;   // Degrees into the sweep span where the next sector starts
+	protected float m_fSweepSectorCenter; // Degrees into the sweep span of the middle of the sector being worked off
+	
+	[Attribute("0", UIWidgets.EditBox, "Moving target indication: minimum radial speed in m/s a target needs to be seen, 0 disables")]
+    protected float m_fMTIMinRadialSpeed;
+	
+	[Attribute("0", UIWidgets.EditBox, "Targets at least this many meters above the terrain pass moving target indication at any speed, 0 disables")]
+    protected float m_fMTIAltitudeExemption;
+	
+	[Attribute("1024", UIWidgets.EditBox, "Contact replication budget per crew member in bytes per second")]
+    protected int m_iReplicationBytesPerSecond;
+	
+	[Attribute("0.25", UIWidgets.EditBox, "Interval in seconds between contact updates sent to the crew")]
+    protected float m_fReplicationInterval;
+	
+	[Attribute("0.5", UIWidgets.EditBox, "Change in azimuth or elevation in degrees before a contact is sent to the crew again")]
+    protected float m_fReplicationAngleThreshold;
+	
+	[Attribute("25", UIWidgets.EditBox, "Range resolution in meters of contacts sent to the crew")]
+    protected float m_fReplicationRangeBucket;
+	
+	protected ref AG0_RadarContactReplicator m_Replicator;       // Server
+	protected ref AG0_RadarContactPicture m_ReplicatedContacts;  // Crew clients
+	
+	protected ref AG0_RadarContactSnapshot m_Snapshot;
+	protected int m_iSnapshotGeneration = -1;   // Contact store generation m_Snapshot was built from
+	protected int m_iSnapshotVersion;
 	
     
     protected bool m_bIsEmitting;
@@ -52,8 +140,14 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
     protected ref array<IEntity> m_DetectedEntities;
 	
 	protected ref array<ref RadarSource> m_PaintingSources;
-    protected ref array<ref RadarContact> m_DetectedContacts;
-    protected ref array<ref RadarContact> m_DisplayableContacts;
+	
+	[Attribute("1.5", UIWidgets.EditBox, "Seconds a painting radar stays at full strength on the RWR after its last paint")]
+    protected float m_fPaintHoldTime;
+	
+	[Attribute("2.0", UIWidgets.EditBox, "Seconds over which a painting radar then fades from the RWR")]
+    protected float m_fPaintDecayTime;
+    protected ref AG0_RadarContactStore m_Contacts;
+    protected ref array<RadarContact> m_aDueContacts = {};
 	
 	static const float SPEED_OF_LIGHT = 299792458; // meters per second
 	static const float MIN_DISPLAY_DELAY = 0.1; // Minimum delay in seconds
@@ -65,6 +159,10 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
 		
 		
         m_DetectedEntities = new array<IEntity>();
+        m_PaintingSources = new array<ref RadarSource>();
+        m_LOSCache = new map<IEntity, ref RadarLOSCacheEntry>();
+        m_ScanFrame = new AG0_RadarScanFrame();
+        UpdateScanFrame();
         m_bIsEmitting = false;
         m_bIsPainted = false;
         m_iIFFKey = -1;
@@ -79,8 +177,12 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         {
             m_fEffectiveDetectionThreshold = m_fBaseDetectionThreshold;
         }
+        UpdateDetectionRanges();
 		
-        Print("RadarComponent initialized on " + owner.GetName() + ". Mode: " + typename.EnumToString(ERadarMode, m_eRadarMode));
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "RadarComponent initialized on " + owner.GetName() + ". Mode: " + typename.EnumToString(ERadarMode, m_eRadarMode), LogLevel.NORMAL);
+#endif
 
 		AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
 	
@@ -91,8 +193,7 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
 	
 	    SetEventMask(owner, EntityEvent.INIT);
 		
-		m_DetectedContacts = new array<ref RadarContact>();
-        m_DisplayableContacts = new array<ref RadarContact>();
+		m_Contacts = new AG0_RadarContactStore();
 
         UpdateRadarSettings();
     }
@@ -102,8 +203,12 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         if (m_eFieldOfView != fov)
         {
             m_eFieldOfView = fov;
+            UpdateScanFrame();
             UpdateRadarSettings();
-            Print("Radar field of view changed to: " + FOVToString(m_eFieldOfView));
+#ifdef ENABLE_DIAG
+            if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+                AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Radar field of view changed to: " + FOVToString(m_eFieldOfView), LogLevel.NORMAL);
+#endif
         }
     }
 	
@@ -118,131 +223,387 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         float fovMultiplier = 360.0 / FOVToFloat(m_eFieldOfView);
         m_fCurrentUpdateInterval = m_fBaseUpdateInterval / fovMultiplier;
 
-        // Remove any existing update callback
-        GetGame().GetCallqueue().Remove(UpdateContacts);
+        // Contact maintenance is driven by AG0_RadarCoverageSystem, which calls UpdateContacts once this is due
+        m_fNextContactUpdateTime = System.GetTickCount() / 1000.0 + m_fCurrentUpdateInterval;
 
-        // Set up new update callback
-        GetGame().GetCallqueue().CallLater(UpdateContacts, m_fCurrentUpdateInterval * 1000, true);
-
-        Print("Radar update interval set to: " + m_fCurrentUpdateInterval + " seconds");
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.DEBUG))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Radar update interval set to: " + m_fCurrentUpdateInterval + " seconds", LogLevel.DEBUG);
+#endif
     }
 	
 	void AddDetectedEntity(IEntity entity, vector position)
     {
-        float azimuth = CalculateAzimuth(position);
-        float elevation = CalculateElevation(position);
-        
-        RadarContact existingContact = FindContact(entity);
-        if (!existingContact)
-        {
-            RadarContact newContact = new RadarContact(entity, position, azimuth, elevation);
-            m_DetectedContacts.Insert(newContact);
-        }
+        AddDetectedContact(entity, position, CalculateAzimuth(position), CalculateElevation(position));
+    }
+	
+	//! Records a detection whose angles the caller already derived from the scan frame
+	void AddDetectedContact(IEntity entity, vector position, float azimuth, float elevation)
+    {
+        RadarContact contact = m_Contacts.Find(entity);
+        if (!contact)
+            contact = m_Contacts.Add(entity, position, azimuth, elevation);
         else
         {
-            existingContact.UpdateDetection(position, azimuth, elevation);
+            contact.UpdateDetection(position, azimuth, elevation);
+            m_Contacts.MarkChanged(contact);
         }
+        
+        OnContactMeasured(contact);
+        
+        // A fresh detection means the contact is in view; make sure it is revealed and refreshed on time
+        m_Contacts.Schedule(contact, GetNextContactEventTime(contact, true));
     }
 	
-	protected RadarContact FindContact(IEntity entity)
+	//! Earliest of the contact's expiry, reveal and, while it is in view, position refresh deadlines
+	protected float GetNextContactEventTime(RadarContact contact, bool inView)
     {
-        foreach (RadarContact contact : m_DetectedContacts)
-        {
-            if (contact.GetEntity() == entity)
-                return contact;
-        }
-        return null;
+        float next = contact.GetLastDetectedTime() + CONTACT_MEMORY_TIME;
+        
+        if (!contact.IsDisplayable())
+            next = Math.Min(next, contact.GetDisplayTime());
+        
+        if (inView && IsEmitting() && !IsSweeping())
+            next = Math.Min(next, contact.GetLastUpdateTime() + contact.GetUpdateInterval());
+        
+        return next;
     }
 	
-	protected void UpdateContacts()
+	float GetNextContactUpdateTime()
+	{
+	    return m_fNextContactUpdateTime;
+	}
+	
+	float GetNextReplicationTime()
+	{
+	    return m_fNextReplicationTime;
+	}
+	
+	//! Expires, reveals and refreshes contacts. Called by AG0_RadarCoverageSystem in its batched contact pass.
+	void UpdateContacts(float currentTime)
     {
-        float currentTime = System.GetTickCount() / 1000.0;
-        vector ownerOrientation = GetOwner().GetAngles();
+        m_fNextContactUpdateTime = currentTime + m_fCurrentUpdateInterval;
+        
+        UpdateScanFrame();
+        PruneLOSCache(currentTime);
 
-        for (int i = m_DetectedContacts.Count() - 1; i >= 0; i--)
+        // Only contacts with a deadline that has passed are touched
+        m_aDueContacts.Clear();
+        m_Contacts.CollectDue(currentTime, m_aDueContacts);
+        bool refreshPositions = IsEmitting() && !IsSweeping();
+        
+        foreach (RadarContact contact : m_aDueContacts)
         {
-            RadarContact contact = m_DetectedContacts[i];
-            
-            if (currentTime - contact.GetLastDetectedTime() > CONTACT_MEMORY_TIME)
+            if (currentTime - contact.GetLastDetectedTime() > CONTACT_MEMORY_TIME || !contact.GetEntity())
             {
-                m_DetectedContacts.RemoveOrdered(i);
-                m_DisplayableContacts.RemoveItem(contact);
+                m_Contacts.Remove(contact);
                 continue;
             }
             
-            if (IsEntityInFOV(contact.GetEntity(), ownerOrientation))
+            // Contacts out of view are only woken again by expiry or by the coverage pass re-detecting them
+            bool inView = IsEntityInFOV(contact.GetEntity());
+            if (inView)
             {
                 if (!contact.IsDisplayable() && contact.ShouldDisplay(currentTime))
-                {
-                    contact.SetDisplayable(true);
-                    m_DisplayableContacts.Insert(contact);
-                }
+                    m_Contacts.SetDisplayable(contact, true);
                 
-                if (contact.ShouldUpdate(currentTime, m_fCurrentUpdateInterval))
+                // A sweeping radar only learns new positions when its beam passes the contact, a silent one not at all
+                if (refreshPositions && contact.ShouldUpdate(currentTime, contact.GetUpdateInterval()))
                 {
                     UpdateContactPosition(contact);
                 }
             }
+            
+            m_Contacts.Schedule(contact, GetNextContactEventTime(contact, inView));
+        }
+        
+        ReplicateContacts(currentTime);
+    }
+	
+	//! Contacts left to expire or removals not yet sent to the crew; the coverage system keeps maintaining the radar until both are done
+	bool HasPendingContactWork()
+    {
+        if (HasContactsToShow())
+            return true;
+        
+        return m_Replicator && !m_Replicator.IsSettled();
+    }
+	
+	//! Cheap check that does not build the network contacts: true when the radar, or its network, holds any contact
+	protected bool HasContactsToShow()
+    {
+        if (!m_Contacts)
+            return false;
+        
+        if (!UsesNetworkPicture())
+            return m_Contacts.Count() > 0;
+        
+        AG0_RadarTrackPicture picture = AG0_RadarCoverageSystem.GetInstance().GetTrackPicture(m_iIFFKey);
+        return picture && picture.Count() > 0;
+    }
+	
+	//! Store the scope, snapshots and crew replication read: the radar's own contacts, or the network's tracks with the network picture.
+	//! Null where this machine holds no contacts.
+	protected AG0_RadarContactStore GetDisplayStore()
+    {
+        if (!m_Contacts || !UsesNetworkPicture())
+            return m_Contacts;
+        
+        SyncNetworkContacts();
+        return m_NetworkContacts;
+    }
+	
+	//! Mirrors the network's track picture into m_NetworkContacts, relative to this radar.
+	//! Only tracks that changed since the last sync are touched, nothing at all while the picture is unchanged.
+	protected void SyncNetworkContacts()
+    {
+        if (!m_NetworkContacts)
+            m_NetworkContacts = new AG0_RadarContactStore();
+        
+        AG0_RadarTrackPicture picture = AG0_RadarCoverageSystem.GetInstance().GetTrackPicture(m_iIFFKey);
+        int generation = -1;
+        if (picture)
+            generation = picture.GetGeneration();
+        
+        // A new IFF key means a different picture, whose generations say nothing about what was synced
+        bool resync = m_iNetworkContactsKey != m_iIFFKey;
+        if (!resync && generation == m_iNetworkPictureGeneration)
+            return;
+        
+        int syncedGeneration = m_iNetworkPictureGeneration;
+        m_iNetworkPictureGeneration = generation;
+        m_iNetworkContactsKey = m_iIFFKey;
+        
+        // Tracks the network dropped
+        array<ref RadarContact> contacts = m_NetworkContacts.GetContacts();
+        for (int i = contacts.Count() - 1; i >= 0; i--)
+        {
+            IEntity entity = contacts[i].GetEntity();
+            if (!picture || !entity || !picture.Find(entity))
+                m_NetworkContacts.Remove(contacts[i]);
+        }
+        
+        if (!picture)
+            return;
+        
+        foreach (AG0_RadarNetworkTrack track : picture.GetTracks())
+        {
+            if (!track.m_Entity || (!resync && track.m_iGeneration <= syncedGeneration))
+                continue;
+            
+            vector relativePosition = track.m_vPosition - m_ScanFrame.m_vOrigin;
+            float azimuth = CalculateAzimuth(relativePosition);
+            float elevation = CalculateElevation(relativePosition);
+            
+            RadarContact contact = m_NetworkContacts.Find(track.m_Entity);
+            if (!contact)
+            {
+                // Already confirmed by the network, so shown right away
+                contact = m_NetworkContacts.Add(track.m_Entity, relativePosition, azimuth, elevation);
+                m_NetworkContacts.SetDisplayable(contact, true);
+                continue;
+            }
+            
+            contact.UpdateDetection(relativePosition, azimuth, elevation);
+            m_NetworkContacts.MarkChanged(contact);
         }
     }
 	
+	//! Sends the crew of the owning vehicle what changed in the displayable contacts, at most every m_fReplicationInterval.
+	//! Called from UpdateContacts and, in between, by AG0_RadarCoverageSystem once GetNextReplicationTime has passed.
+	void ReplicateContacts(float currentTime)
+    {
+        if (currentTime < m_fNextReplicationTime)
+            return;
+        
+        m_fNextReplicationTime = currentTime + m_fReplicationInterval;
+        
+        // Nothing to show and every removal delivered: no need to even look for crew
+        if (!HasContactsToShow() && (!m_Replicator || m_Replicator.IsSettled()))
+            return;
+        
+        if (!m_Replicator)
+            m_Replicator = new AG0_RadarContactReplicator(this);
+        
+        m_Replicator.Update(currentTime);
+    }
+	
+	//! Client side: applies a contact delta received through SCR_PlayerController
+	void ApplyContactDelta(bool reset, notnull array<int> updates, notnull array<int> removals)
+    {
+        if (!m_ReplicatedContacts)
+            m_ReplicatedContacts = new AG0_RadarContactPicture();
+        
+        m_ReplicatedContacts.ApplyDelta(reset, updates, removals, m_fReplicationRangeBucket);
+    }
+	
+	//! Changes whenever a contact is added, removed, revealed or moved; -1 where this machine holds no contacts
+	int GetContactGeneration()
+    {
+        AG0_RadarContactStore store = GetDisplayStore();
+        if (!store)
+            return -1;
+        
+        return store.GetGeneration();
+    }
+	
+	//! Contacts as replicated to this client, null until the first delta arrived
+	AG0_RadarContactPicture GetReplicatedContacts()
+    {
+        return m_ReplicatedContacts;
+    }
+	
+	int GetReplicationBytesPerSecond()
+    {
+        return m_iReplicationBytesPerSecond;
+    }
+	
+	float GetReplicationAngleThreshold()
+    {
+        return m_fReplicationAngleThreshold;
+    }
+	
+	float GetReplicationRangeBucket()
+    {
+        return m_fReplicationRangeBucket;
+    }
+	
+	//! Unordered. Contacts are pooled, so do not keep references past the current frame.
+	//! Consumers outside the radar should prefer GetContactSnapshot.
 	array<ref RadarContact> GetDisplayableContacts()
     {
-        return m_DisplayableContacts;
+        return GetDisplayStore().GetDisplayable();
     }
 	
-	bool IsEntityInFOV(IEntity entity, vector ownerOrientation)
+	//! Immutable copy of the displayable contacts. Only rebuilt, with a new version, when a caller asks after the contacts changed.
+	//! Null where this machine holds no contacts; remote crew use GetReplicatedContacts instead.
+	AG0_RadarContactSnapshot GetContactSnapshot()
     {
-        vector directionToEntity = entity.GetOrigin() - GetOwner().GetOrigin();
-        directionToEntity.Normalize();
+        AG0_RadarContactStore store = GetDisplayStore();
+        if (!store)
+            return null;
+        
+        int generation = store.GetGeneration();
+        if (!m_Snapshot || generation != m_iSnapshotGeneration)
+        {
+            m_iSnapshotVersion++;
+            m_iSnapshotGeneration = generation;
+            m_Snapshot = new AG0_RadarContactSnapshot(m_iSnapshotVersion, store.GetDisplayable(), System.GetTickCount() / 1000.0);
+        }
         
-        vector forwardVector = ownerOrientation;
-        forwardVector.Normalize();
+        return m_Snapshot;
+    }
+	
+	//! Cheap check before GetContactSnapshot: true when a snapshot taken now would differ from the given version
+	bool HasContactsChangedSince(int snapshotVersion)
+    {
+        AG0_RadarContactStore store = GetDisplayStore();
+        if (!store)
+            return false;
         
-        float angle = Math.Acos(vector.Dot(forwardVector, directionToEntity)) * Math.RAD2DEG;
-        float halfFOV = FOVToFloat(m_eFieldOfView) / 2;
+        return !m_Snapshot || m_iSnapshotVersion != snapshotVersion || store.GetGeneration() != m_iSnapshotGeneration;
+    }
+	
+	//! Refreshes the cached radar pose and limits. Called once per coverage cycle and contact update, not per target.
+	void UpdateScanFrame()
+	{
+	    m_ScanFrame.Update(GetOwner(), FOVToFloat(m_eFieldOfView), m_fMaxRange);
+	}
+	
+	AG0_RadarScanFrame GetScanFrame()
+	{
+	    return m_ScanFrame;
+	}
+	
+	bool IsEntityInFOV(IEntity entity)
+    {
+        if (!entity)
+            return false;
         
-        return angle <= halfFOV;
+        return m_ScanFrame.IsInFOV(entity.GetOrigin() - m_ScanFrame.m_vOrigin);
     }
 	
 	void UpdateContactPosition(RadarContact contact)
     {
         IEntity entity = contact.GetEntity();
-        vector entityPos = entity.GetOrigin();
-        vector radarPos = GetOwner().GetOrigin();
-        
-        vector relativePosition = entityPos - radarPos;
+        vector relativePosition = entity.GetOrigin() - m_ScanFrame.m_vOrigin;
         float azimuth = CalculateAzimuth(relativePosition);
         float elevation = CalculateElevation(relativePosition);
         
-        contact.UpdateDetection(relativePosition, azimuth, elevation);
+        contact.UpdatePosition(relativePosition, azimuth, elevation);
         contact.MarkAsUpdated();
+        OnContactMeasured(contact);
+        m_Contacts.MarkChanged(contact);
+    }
+	
+	//! Per-contact bookkeeping after every new measurement
+	protected void OnContactMeasured(RadarContact contact)
+    {
+        contact.SetUpdateInterval(CalculateContactUpdateInterval(contact));
+        
+        if (m_bTrackFilter)
+            contact.UpdateTrackFilter(m_fTrackAlpha, m_fTrackBeta);
+    }
+	
+	//! Level of detail of a contact: the radar's update interval up close, growing with range, and shortened again so
+	//! the contact neither turns by more than m_fLODAngleStep nor closes by more than m_fLODRangeStep between refreshes
+	float CalculateContactUpdateInterval(RadarContact contact)
+    {
+        float interval = m_fCurrentUpdateInterval * Math.Max(contact.GetDistance() / m_fLODNearRange, 1);
+        
+        float angularRate = contact.GetAngularRate();
+        if (angularRate > 0)
+            interval = Math.Min(interval, m_fLODAngleStep / angularRate);
+        
+        float closingSpeed = Math.AbsFloat(contact.GetClosingSpeed());
+        if (closingSpeed > 0)
+            interval = Math.Min(interval, m_fLODRangeStep / closingSpeed);
+        
+        return Math.Clamp(interval, m_fCurrentUpdateInterval, Math.Max(m_fLODMaxInterval, m_fCurrentUpdateInterval));
+    }
+	
+	//! False while an existing contact of entity was confirmed recently enough for its level of detail, the coverage pass
+	//! then skips the expensive checks. Only detections count, maintenance refreshes never postpone the terrain and LOS re-check.
+	//! Sweeping radars are already paced by their beam.
+	bool IsRedetectionDue(IEntity entity, float currentTime)
+    {
+        if (IsSweeping())
+            return true;
+        
+        RadarContact contact = m_Contacts.Find(entity);
+        if (!contact)
+            return true;
+        
+        return currentTime >= contact.GetLastDetectedTime() + contact.GetUpdateInterval();
     }
 
-	float CalculateAzimuth(vector relativePosition)
+	//! Doppler gate on the coverage snapshot: relativePosition from the radar to the target, velocity of the target.
+	//! The altitude exemption costs a terrain lookup and is only consulted for targets the speed test rejected.
+	bool PassesMovingTargetIndication(vector relativePosition, vector velocity, vector targetPosition)
     {
-        vector horizontalPos = Vector(relativePosition[0], 0, relativePosition[2]);
-        vector forwardVector = GetOwner().GetTransformAxis(2);
-        forwardVector[1] = 0; // Project to horizontal plane
-        forwardVector.Normalize();
+        if (m_fMTIMinRadialSpeed <= 0)
+            return true;
         
-        float angle = Math.Acos(vector.Dot(forwardVector, horizontalPos.Normalized())) * Math.RAD2DEG;
+        // |v . r| / |r| >= min, squared to stay clear of the square root
+        float radial = vector.Dot(velocity, relativePosition);
+        if (radial * radial >= m_fMTIMinRadialSpeed * m_fMTIMinRadialSpeed * relativePosition.LengthSq())
+            return true;
         
-        // Determine if the angle is left or right of forward
-        if (vector.Dot(GetOwner().GetTransformAxis(0), horizontalPos) < 0)
-        {
-            angle = 360 - angle;
-        }
+        if (m_fMTIAltitudeExemption <= 0)
+            return false;
         
-        return angle;
+        float surfaceY = GetOwner().GetWorld().GetSurfaceY(targetPosition[0], targetPosition[2]);
+        return targetPosition[1] - surfaceY >= m_fMTIAltitudeExemption;
+    }
+	
+	float CalculateAzimuth(vector relativePosition)
+    {
+        return m_ScanFrame.GetAzimuth(relativePosition);
     }
 	
 	float CalculateElevation(vector relativePosition)
     {
-        vector horizontalPos = Vector(relativePosition[0], 0, relativePosition[2]);
-        float horizontalDistance = horizontalPos.Length();
-        
-        return Math.Atan2(relativePosition[1], horizontalDistance) * Math.RAD2DEG;
+        return m_ScanFrame.GetElevation(relativePosition);
     }
 	
 	static float FOVToFloat(ERadarFOV fov)
@@ -272,23 +633,61 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         float detectionRange = m_fMaxRange * m_fDetectionRangeFraction;
         m_fEffectiveDetectionThreshold = m_fRadarStrength / (detectionRange * detectionRange);
         
-        Print("Auto-calculated detection threshold: " + m_fEffectiveDetectionThreshold + 
-              " (Max Range: " + m_fMaxRange + 
-              ", Detection Range: " + detectionRange + 
-              ", Radar Strength: " + m_fRadarStrength + ")");
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.DEBUG))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Auto-calculated detection threshold: " + m_fEffectiveDetectionThreshold + " (Max Range: " + m_fMaxRange + ", Detection Range: " + detectionRange + ", Radar Strength: " + m_fRadarStrength + ")", LogLevel.DEBUG);
+#endif
+    }
+	
+	//! Solves strength * factor == threshold for every cross-section class, capped at the maximum range
+	void UpdateDetectionRanges()
+    {
+        m_aDetectionRangesSq.Clear();
+        float maxRangeSq = m_fMaxRange * m_fMaxRange;
+        
+        for (int crossSection = ERadarCrossSection.SMALL; crossSection <= ERadarCrossSection.LARGE; crossSection++)
+        {
+            float rangeSq = maxRangeSq;
+            if (m_fEffectiveDetectionThreshold > 0)
+                rangeSq = Math.Min(rangeSq, m_fRadarStrength * GetCrossSectionFactor(crossSection) / m_fEffectiveDetectionThreshold);
+            
+            m_aDetectionRangesSq.Insert(rangeSq);
+        }
+    }
+	
+	float GetDetectionRangeSq(ERadarCrossSection crossSection)
+    {
+        return m_aDetectionRangesSq[crossSection];
+    }
+	
+	//! Echo strength relative to a medium sized vehicle
+	static float GetCrossSectionFactor(ERadarCrossSection crossSection)
+    {
+        switch (crossSection)
+        {
+            case ERadarCrossSection.SMALL: return 0.25;
+            case ERadarCrossSection.LARGE: return 4.0;
+        }
+        return 1.0;
     }
 	
 	bool CanEmit()
     {
         bool canEmit = (m_eRadarMode == ERadarMode.EMIT_ONLY || m_eRadarMode == ERadarMode.EMIT_AND_DETECT);
-        Print("CanEmit checked for " + GetOwner().GetName() + ": " + canEmit);
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "CanEmit checked for " + GetOwner().GetName() + ": " + canEmit, LogLevel.SPAM);
+#endif
         return canEmit;
     }
 	
 	bool CanDetect()
     {
         bool canDetect = (m_eRadarMode == ERadarMode.DETECT_ONLY || m_eRadarMode == ERadarMode.EMIT_AND_DETECT);
-        Print("CanDetect checked for " + GetOwner().GetName() + ": " + canDetect);
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "CanDetect checked for " + GetOwner().GetName() + ": " + canDetect, LogLevel.SPAM);
+#endif
         return canDetect;
     }
     
@@ -297,11 +696,22 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
 		if (CanEmit())
         {
             m_bIsEmitting = isEmitting;
-            Print("Radar emission set to: " + m_bIsEmitting + " on " + GetOwner().GetName());
+            
+            if (m_bIsEmitting && m_bStaticEmplacement)
+                BakeHorizonMask();
+            
+            AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+            if (radarSystem)
+                radarSystem.OnEmitterStateChanged(this);
+            
+#ifdef ENABLE_DIAG
+            if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+                AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Radar emission set to: " + m_bIsEmitting + " on " + GetOwner().GetName(), LogLevel.NORMAL);
+#endif
         }
         else
         {
-            Print("Cannot set emitting on " + GetOwner().GetName() + ". Current mode: " + typename.EnumToString(ERadarMode, m_eRadarMode));
+            Print("Cannot set emitting on " + GetOwner().GetName() + ". Current mode: " + typename.EnumToString(ERadarMode, m_eRadarMode), LogLevel.WARNING);
         }
     }
     
@@ -310,6 +720,55 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         bool canEmit = (m_eRadarMode == ERadarMode.EMIT_ONLY || m_eRadarMode == ERadarMode.EMIT_AND_DETECT);
         return m_bIsEmitting && canEmit;
     }
+	
+	bool IsSweeping()
+    {
+        return m_bSweepMode && m_fSweepRate > 0 && m_fBeamWidth > 0;
+    }
+	
+	float GetBeamWidth()
+    {
+        return m_fBeamWidth;
+    }
+	
+	//! Angle the beam travels through: the full circle, or the field of view from its left edge to its right edge
+	float GetSweepSpan()
+    {
+        return FOVToFloat(m_eFieldOfView);
+    }
+	
+	//! Returns the arc the beam covers over the next duration seconds and moves the beam past it.
+	//! start is the offset of the arc into the sweep span.
+	float AdvanceSweep(float duration, out float start)
+    {
+        float span = GetSweepSpan();
+        float arc = Math.Min(m_fSweepRate * duration, span);
+        
+        start = m_fSweepPosition;
+        m_fSweepSectorCenter = start + arc * 0.5;
+        if (m_fSweepSectorCenter >= span)
+            m_fSweepSectorCenter -= span;
+        
+        m_fSweepPosition += arc;
+        if (m_fSweepPosition >= span)
+            m_fSweepPosition -= span;
+        
+        return arc;
+    }
+	
+	//! Middle of the sector the coverage system is currently working off, as an azimuth clockwise from forward,
+	//! for scope displays. Contacts in that sector are the ones being refreshed.
+	float GetSweepAzimuth()
+    {
+        float azimuth = m_fSweepSectorCenter;
+        if (!m_ScanFrame.m_bFullCircle)
+            azimuth -= GetSweepSpan() * 0.5;
+        
+        if (azimuth < 0)
+            azimuth += 360;
+        
+        return azimuth;
+    }
     
     void SetIFFKey(int key)
     {
@@ -321,19 +780,137 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         return m_iIFFKey;
     }
 	
+	//! True when detections go to the network's track picture instead of the radar's own contacts; needs an IFF key
+	bool UsesNetworkPicture()
+    {
+        return m_bUseNetworkPicture && m_iIFFKey >= 0;
+    }
+	
 	void AddDetectedEntity(IEntity entity)
 	{
 	    if (!m_DetectedEntities.Contains(entity))
 	        m_DetectedEntities.Insert(entity);
 	}
     
+	//! Starts (or resumes) baking the horizon mask; AG0_RadarCoverageSystem carries it out over several frames
+    protected void BakeHorizonMask()
+    {
+        vector origin = GetOwner().GetOrigin();
+        if (m_HorizonMask && m_HorizonMask.IsValidFor(origin))
+            return;
+        
+        AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+        if (!radarSystem)
+            return;
+        
+        if (!m_HorizonMask)
+            m_HorizonMask = new AG0_RadarHorizonMask();
+        
+        if (!m_HorizonMask.IsBakingFor(origin))
+            m_HorizonMask.BeginBake(origin, m_fMaxRange, m_iHorizonAzimuthBins, m_fHorizonRingSpacing);
+        
+        radarSystem.QueueHorizonBake(this);
+    }
+	
+	//! Bakes up to maxSamples height queries of the pending horizon mask, returns the number used
+	int ContinueHorizonBake(int maxSamples)
+    {
+        if (!m_HorizonMask || m_HorizonMask.IsBaked())
+            return 0;
+        
+        int samples = m_HorizonMask.BakeStep(maxSamples);
+        
+#ifdef ENABLE_DIAG
+        if (m_HorizonMask.IsBaked() && AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Horizon mask baked for " + GetOwner().GetName() + " (" + m_iHorizonAzimuthBins + " bins, " + m_fHorizonRingSpacing + " m spacing)", LogLevel.NORMAL);
+#endif
+        return samples;
+    }
+	
+	bool IsHorizonMaskPending()
+    {
+        return m_HorizonMask && !m_HorizonMask.IsBaked();
+    }
+    
+    //! Cheap pre-trace rejection of targets hidden behind terrain. Always false for radars without a valid baked mask.
+    bool IsTerrainMasked(vector radarPos, vector targetPos)
+    {
+        if (!m_HorizonMask || !m_HorizonMask.IsValidFor(radarPos))
+            return false;
+        
+        return m_HorizonMask.IsBelowHorizon(targetPos);
+    }
+    
     bool IsInLineOfSight(IEntity target)
     {
-        vector startPos = GetOwner().GetOrigin();
-        vector endPos = target.GetOrigin();
+        bool traced;
+        return CheckLineOfSight(target, target.GetOrigin(), traced);
+    }
+	
+	//! Line of sight test that reuses the last result for this target while neither end has moved past
+	//! m_fLOSCacheTolerance and the result is younger than m_fLOSCacheMaxAge.
+	//! \param[out] traced true when a trace had to be issued, false on a cache hit
+	bool CheckLineOfSight(IEntity target, vector targetPos, out bool traced)
+	{
+	    vector startPos = GetOwner().GetOrigin();
+	    bool clear;
+	    if (GetCachedLineOfSight(target, startPos, targetPos, clear))
+	    {
+	        traced = false;
+	        return clear;
+	    }
+	
+	    traced = true;
+	    clear = TraceLineOfSight(target, startPos, targetPos);
+	    StoreLineOfSight(target, startPos, targetPos, clear);
+	    return clear;
+	}
+	
+	//! \return true when a cached result for the segment exists, clear then holds it
+	bool GetCachedLineOfSight(IEntity target, vector startPos, vector targetPos, out bool clear)
+	{
+	    RadarLOSCacheEntry entry;
+	    if (!m_LOSCache.Find(target, entry))
+	        return false;
+	    
+	    float currentTime = System.GetTickCount() / 1000.0;
+	    float invTolerance = 1.0 / Math.Max(m_fLOSCacheTolerance, 0.01);
+	    if (currentTime - entry.m_fTime > m_fLOSCacheMaxAge || !entry.Matches(startPos, targetPos, invTolerance))
+	        return false;
+	    
+	    clear = entry.m_bClear;
+	    return true;
+	}
+	
+	//! Caches a trace result, whether this radar traced it or AG0_RadarCoverageSystem shared another radar's trace
+	void StoreLineOfSight(IEntity target, vector startPos, vector targetPos, bool clear)
+	{
+	    RadarLOSCacheEntry entry;
+	    if (!m_LOSCache.Find(target, entry))
+	    {
+	        entry = new RadarLOSCacheEntry();
+	        m_LOSCache.Insert(target, entry);
+	    }
+	    
+	    float invTolerance = 1.0 / Math.Max(m_fLOSCacheTolerance, 0.01);
+	    entry.Store(startPos, targetPos, invTolerance, clear, System.GetTickCount() / 1000.0);
+	}
+	
+	//! Drops cache entries that can no longer be hit, including those of deleted targets
+	protected void PruneLOSCache(float currentTime)
+	{
+	    for (int i = m_LOSCache.Count() - 1; i >= 0; i--)
+	    {
+	        if (!m_LOSCache.GetKey(i) || currentTime - m_LOSCache.GetElement(i).m_fTime > m_fLOSCacheMaxAge)
+	            m_LOSCache.RemoveElement(i);
+	    }
+	}
+    
+    //! Both the radar's owner and the target are excluded, so tracing the segment in either direction gives the same result
+    bool TraceLineOfSight(IEntity target, vector startPos, vector endPos)
+    {
         vector direction = endPos - startPos;
         float distance = direction.Length();
-		Print("Distance between radar and target: " + distance);
         direction.Normalize();
         
         BaseWorld world = GetGame().GetWorld();
@@ -343,29 +920,25 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         trace.End = startPos + direction * distance;
         trace.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
         trace.LayerMask = TRACE_LAYER_CAMERA;
-        trace.Exclude = GetOwner();
+        trace.ExcludeArray = {GetOwner(), target};
         
         if (startPos[1] > world.GetOceanBaseHeight())
             trace.Flags = trace.Flags | TraceFlags.OCEAN;
         
-         float traceScale = GetGame().GetWorld().TraceMove(trace, null);
-        
-        Print("Trace result for " + GetOwner().GetName() + " to " + target.GetName() + ": " + traceScale);
+        float traceScale = world.TraceMove(trace, null);
 
         // If traceScale is very close to 1 (allowing for floating-point imprecision, and collision with model components),
         // or if the difference between full distance and traced distance is very small,
         // we consider it a clear line of sight
         const float EPSILON = 0.035; // Adjust this value as needed
-        if (traceScale >= (1 - EPSILON) || (distance * (1 - traceScale)) < EPSILON)
-        {
-            Print("Clear line of sight detected");
-            return true;
-        }
-        else
-        {
-            Print("Line of sight obstructed at " + (traceScale * 100) + "% of the distance");
-            return false;
-        }
+        bool clear = traceScale >= (1 - EPSILON) || (distance * (1 - traceScale)) < EPSILON;
+        
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.LOS, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.LOS, "Trace " + GetOwner().GetName() + " -> " + target.GetName() + " (" + distance + " m): " + traceScale + ", clear: " + clear, LogLevel.SPAM);
+#endif
+        
+        return clear;
     }
 	
 	float CalculateRelativeAngleTo(IEntity target)
@@ -443,44 +1016,122 @@ class AG0_RadarRecieverTransmitterComponent : ScriptComponent
         // Prevent division by zero
         if (distance < 0.01) // Use a small threshold to avoid extremely large values
         {
-            Print("Warning: Very small distance detected. Using minimum distance of 0.01");
+#ifdef ENABLE_DIAG
+            if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.COVERAGE, LogLevel.DEBUG))
+                AG0_RadarLog.Log(EAG0_RadarLogCategory.COVERAGE, "Very small distance detected. Using minimum distance of 0.01", LogLevel.DEBUG);
+#endif
             distance = 0.01;
         }
 
         //inverse square law for detection
-        float strength = m_fRadarStrength / (distance * distance);
-        Print("Detection strength calculated: " + strength + " (Distance: " + distance + ", Radar Strength: " + m_fRadarStrength + ")");
+        float strength = CalculateDetectionStrengthSq(distance * distance);
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.COVERAGE, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.COVERAGE, "Detection strength calculated: " + strength + " (Distance: " + distance + ", Radar Strength: " + m_fRadarStrength + ")", LogLevel.SPAM);
+#endif
         return strength;
     }
 	
     
+	//! Inverse square strength straight from a squared distance, so callers never need the square root
+	float CalculateDetectionStrengthSq(float distanceSq)
+	{
+	    return m_fRadarStrength / Math.Max(distanceSq, 0.0001);
+	}
+    
     void SetPainted(bool isPainted, float angle = 0, float strength = 0, int key = -1)
     {
         if (CanDetect())
         {
-            m_bIsPainted = isPainted;
             if (isPainted)
             {
-                m_fPaintedAngle = angle;
-                m_fPaintedStrength = strength;
-                Print(GetOwner().GetName() + " painted by radar. Angle: " + angle + ", Strength: " + strength + " Radar IFF: " + key);
+                Paint(null, angle, strength);
+#ifdef ENABLE_DIAG
+                if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.PAINTING, LogLevel.DEBUG))
+                    AG0_RadarLog.Log(EAG0_RadarLogCategory.PAINTING, GetOwner().GetName() + " painted by radar. Angle: " + angle + ", Strength: " + strength + " Radar IFF: " + key, LogLevel.DEBUG);
+#endif
             }
             else
             {
-                Print(GetOwner().GetName() + " no longer painted by radar");
+                m_PaintingSources.Clear();
+                m_bIsPainted = false;
+#ifdef ENABLE_DIAG
+                if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.PAINTING, LogLevel.DEBUG))
+                    AG0_RadarLog.Log(EAG0_RadarLogCategory.PAINTING, GetOwner().GetName() + " no longer painted by radar", LogLevel.DEBUG);
+#endif
             }
         }
         else
         {
-            Print("Cannot set painted on " + GetOwner().GetName() + ". Current mode: " + typename.EnumToString(ERadarMode, m_eRadarMode));
+            Print("Cannot set painted on " + GetOwner().GetName() + ". Current mode: " + typename.EnumToString(ERadarMode, m_eRadarMode), LogLevel.WARNING);
+        }
+    }
+	
+	//! Records a paint by source, called by AG0_RadarCoverageSystem for every detection of the owner.
+	//! Each painting radar keeps its own entry, so several painters no longer overwrite each other.
+	void Paint(AG0_RadarRecieverTransmitterComponent source, float angle, float strength)
+    {
+        RadarSource painter;
+        foreach (RadarSource candidate : m_PaintingSources)
+        {
+            if (candidate.GetSourceRadar() == source)
+            {
+                painter = candidate;
+                break;
+            }
+        }
+        
+        if (!painter)
+        {
+            painter = new RadarSource(source);
+            m_PaintingSources.Insert(painter);
         }
+        
+        painter.Update(angle, strength, System.GetTickCount() / 1000.0);
     }
 	
+	//! One pass over the painters: drops the ones that faded out and takes the strongest remaining one as the painted angle and strength
+	protected void AggregatePainters(float currentTime)
+    {
+        m_bIsPainted = false;
+        m_fPaintedStrength = 0;
+        
+        for (int i = m_PaintingSources.Count() - 1; i >= 0; i--)
+        {
+            RadarSource painter = m_PaintingSources[i];
+            float strength = painter.GetDecayedStrength(currentTime, m_fPaintHoldTime, m_fPaintDecayTime);
+            if (strength <= 0)
+            {
+                m_PaintingSources.Remove(i);
+                continue;
+            }
+            
+            if (strength > m_fPaintedStrength)
+            {
+                m_bIsPainted = true;
+                m_fPaintedStrength = strength;
+                m_fPaintedAngle = painter.GetRelativeDirection();
+            }
+        }
+    }
+	
+	//! Every radar currently painting the owner; strengths are the undecayed values of the last paint
+	array<ref RadarSource> GetPaintingSources()
+    {
+        AggregatePainters(System.GetTickCount() / 1000.0);
+        return m_PaintingSources;
+    }
+	
+	//! Strongest painter, faded by how long ago it last painted
 	bool IsPainted(out float angle, out float strength)
     {
+        AggregatePainters(System.GetTickCount() / 1000.0);
        	angle = m_fPaintedAngle;
         strength = m_fPaintedStrength;
-        Print("Painted status checked for " + GetOwner().GetName() + ". Is Painted: " + m_bIsPainted + ", Angle: " + angle + ", Strength: " + strength);
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.PAINTING, LogLevel.SPAM))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.PAINTING, "Painted status checked for " + GetOwner().GetName() + ". Is Painted: " + m_bIsPainted + ", Angle: " + angle + ", Strength: " + strength, LogLevel.SPAM);
+#endif
         return m_bIsPainted;
     }
     
@@ -515,16 +1166,31 @@ class RadarSource
     protected AG0_RadarRecieverTransmitterComponent m_SourceRadar;
     protected float m_fRelativeDirection;
     protected float m_fStrength;
+    protected float m_fLastPaintedTime;
 
     void RadarSource(AG0_RadarRecieverTransmitterComponent sourceRadar)
     {
         m_SourceRadar = sourceRadar;
     }
 
-    void Update(float direction, float strength)
+    void Update(float direction, float strength, float time)
     {
         m_fRelativeDirection = direction;
         m_fStrength = strength;
+        m_fLastPaintedTime = time;
+    }
+
+    //! Full strength for holdTime after the last paint, then fading linearly to zero over decayTime
+    float GetDecayedStrength(float currentTime, float holdTime, float decayTime)
+    {
+        float fadeAge = currentTime - m_fLastPaintedTime - holdTime;
+        if (fadeAge <= 0)
+            return m_fStrength;
+
+        if (fadeAge >= decayTime)
+            return 0;
+
+        return m_fStrength * (1 - fadeAge / decayTime);
     }
 
     AG0_RadarRecieverTransmitterComponent GetSourceRadar()
@@ -543,6 +1209,42 @@ class RadarSource
     }
 }
 
+class RadarLOSCacheEntry
+{
+    // Endpoints quantized to m_fLOSCacheTolerance sized steps
+    int m_iStartX, m_iStartY, m_iStartZ;
+    int m_iEndX, m_iEndY, m_iEndZ;
+    bool m_bClear;
+    float m_fTime;
+
+    void Store(vector startPos, vector endPos, float invTolerance, bool clear, float time)
+    {
+        m_iStartX = Quantize(startPos[0], invTolerance);
+        m_iStartY = Quantize(startPos[1], invTolerance);
+        m_iStartZ = Quantize(startPos[2], invTolerance);
+        m_iEndX = Quantize(endPos[0], invTolerance);
+        m_iEndY = Quantize(endPos[1], invTolerance);
+        m_iEndZ = Quantize(endPos[2], invTolerance);
+        m_bClear = clear;
+        m_fTime = time;
+    }
+
+    bool Matches(vector startPos, vector endPos, float invTolerance)
+    {
+        return m_iStartX == Quantize(startPos[0], invTolerance)
+            && m_iStartY == Quantize(startPos[1], invTolerance)
+            && m_iStartZ == Quantize(startPos[2], invTolerance)
+            && m_iEndX == Quantize(endPos[0], invTolerance)
+            && m_iEndY == Quantize(endPos[1], invTolerance)
+            && m_iEndZ == Quantize(endPos[2], invTolerance);
+    }
+
+    static int Quantize(float value, float invTolerance)
+    {
+        return Math.Floor(value * invTolerance);
+    }
+}
+
 class RadarContact
 {
     protected IEntity m_Entity;
@@ -551,38 +1253,120 @@ class RadarContact
 	protected float m_fAngle;
     protected float m_fAzimuth;        // Horizontal angle (0-360 degrees)
     protected float m_fElevation;      // Vertical angle (-90 to 90 degrees)
-    protected float m_fLastDetectedTime;
+    protected float m_fLastDetectedTime;   // Last detection confirmed by the coverage pass, drives expiry and re-detection
+    protected float m_fLastMeasuredTime;   // Last position sample, detection or maintenance refresh
     protected float m_fLastUpdateTime;
     protected bool m_bIsDisplayable;
     protected float m_fDisplayTime;
+    protected float m_fClosingSpeed;     // Meters per second towards the radar, negative when opening
+    protected float m_fAngularRate;      // Degrees per second of azimuth change
+    protected float m_fUpdateInterval;   // Level of detail chosen by the radar, see CalculateContactUpdateInterval
+    protected ref AG0_RadarTrackFilter m_TrackFilter;   // Kept across pooling, only used while m_bTrackFiltered
+    protected bool m_bTrackFiltered;
+    
+    // Slots in the owning AG0_RadarContactStore, -1 when not stored / not displayable
+    AG0_RadarContactStore m_Store;  // Owner, null while pooled; pooled contacts are shared by every radar's store
+    int m_iStoreIndex = -1;
+    int m_iDisplayIndex = -1;
+    int m_iWheelTick = -1;      // Tick the contact is scheduled for in the store's timing wheel, -1 when unscheduled
+    int m_iTrackId;             // 16 bit id assigned by the store, identifies the contact in replicated deltas
+    int m_iGeneration;          // Store generation of the contact's last change
+
+    static const float MIN_RATE_INTERVAL = 0.05;
 
     void RadarContact(IEntity entity, vector position, float azimuth, float elevation)
+    {
+        Reset(entity, position, azimuth, elevation);
+    }
+    
+    //! Reinitializes a pooled contact for a new track
+    void Reset(IEntity entity, vector position, float azimuth, float elevation)
     {
         m_Entity = entity;
+        m_fLastDetectedTime = 0;
+        m_fLastMeasuredTime = 0;
+        m_fClosingSpeed = 0;
+        m_fAngularRate = 0;
+        m_fUpdateInterval = 0;
+        m_bTrackFiltered = false;
+        if (m_TrackFilter)
+            m_TrackFilter.Reset();
+        
         UpdateDetection(position, azimuth, elevation);
         m_bIsDisplayable = false;
         m_fLastUpdateTime = System.GetTickCount() / 1000.0;
     }
 
+    //! A detection confirmed by the coverage pass: new position, and the contact's expiry and reveal are renewed
     void UpdateDetection(vector position, float azimuth, float elevation)
     {
-        m_fLastDetectedTime = System.GetTickCount() / 1000.0;
-        m_vPosition = position;
-        m_fDistance = position.Length();
-        m_fAzimuth = azimuth;
-		m_fAngle = azimuth;
-        m_fElevation = elevation;
+        UpdatePosition(position, azimuth, elevation);
+        m_fLastDetectedTime = m_fLastMeasuredTime;
         
         // Calculate display time based on radar wave travel time
         float travelTime = (2 * m_fDistance) / AG0_RadarRecieverTransmitterComponent.SPEED_OF_LIGHT;
         m_fDisplayTime = m_fLastDetectedTime + Math.Max(travelTime, AG0_RadarRecieverTransmitterComponent.MIN_DISPLAY_DELAY);
     }
 
+    //! New position sample without a detection, e.g. a maintenance refresh; expiry is left alone
+    void UpdatePosition(vector position, float azimuth, float elevation)
+    {
+        float currentTime = System.GetTickCount() / 1000.0;
+        float distance = position.Length();
+        
+        // Rates from the previous sample; samples closer together than MIN_RATE_INTERVAL keep the last rates
+        float elapsed = currentTime - m_fLastMeasuredTime;
+        if (m_fLastMeasuredTime > 0 && elapsed >= MIN_RATE_INTERVAL)
+        {
+            float azimuthDelta = Math.AbsFloat(azimuth - m_fAzimuth);
+            if (azimuthDelta > 180)
+                azimuthDelta = 360 - azimuthDelta;
+            
+            m_fAngularRate = azimuthDelta / elapsed;
+            m_fClosingSpeed = (m_fDistance - distance) / elapsed;
+        }
+        
+        m_fLastMeasuredTime = currentTime;
+        m_vPosition = position;
+        m_fDistance = distance;
+        m_fAzimuth = azimuth;
+		m_fAngle = azimuth;
+        m_fElevation = elevation;
+    }
+
     vector GetPosition()
     {
         return m_vPosition;
     }
 
+    //! Feeds the latest measurement into the track filter, creating it on first use
+    void UpdateTrackFilter(float alpha, float beta)
+    {
+        if (!m_TrackFilter)
+            m_TrackFilter = new AG0_RadarTrackFilter();
+        
+        m_TrackFilter.Update(m_vPosition, m_fLastMeasuredTime, alpha, beta);
+        m_bTrackFiltered = true;
+    }
+
+    //! Position relative to the radar predicted for time; the last measured position when the track is not filtered
+    vector GetExtrapolatedPosition(float time)
+    {
+        if (!m_bTrackFiltered || !m_TrackFilter.HasVelocity())
+            return m_vPosition;
+        
+        return m_TrackFilter.Extrapolate(time);
+    }
+
+    //! Estimated velocity in meters per second, zero when the track is not filtered
+    vector GetEstimatedVelocity()
+    {
+        if (!m_bTrackFiltered || !m_TrackFilter.HasVelocity())
+            return vector.Zero;
+        
+        return m_TrackFilter.GetVelocity();
+    }
+
     float GetDistance()
     {
         return m_fDistance;
@@ -613,6 +1397,36 @@ class RadarContact
         return m_fLastDetectedTime;
     }
 
+    float GetClosingSpeed()
+    {
+        return m_fClosingSpeed;
+    }
+
+    float GetAngularRate()
+    {
+        return m_fAngularRate;
+    }
+
+    float GetUpdateInterval()
+    {
+        return m_fUpdateInterval;
+    }
+
+    void SetUpdateInterval(float interval)
+    {
+        m_fUpdateInterval = interval;
+    }
+
+    float GetDisplayTime()
+    {
+        return m_fDisplayTime;
+    }
+
+    float GetLastUpdateTime()
+    {
+        return m_fLastUpdateTime;
+    }
+
     bool ShouldDisplay(float currentTime)
     {
         return currentTime >= m_fDisplayTime;
@@ -649,4 +1463,10 @@ enum ERadarFOV {
     FOV_30=30,
     FOV_90=90,
     FOV_360=360
+}
+
+enum ERadarCrossSection {
+    SMALL,
+    MEDIUM,
+    LARGE
 }
\ No newline at end of file
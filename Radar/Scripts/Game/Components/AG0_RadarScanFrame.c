@@ -0,0 +1,86 @@
+//! Radar pose and limits captured once per scan so per-target tests are plain squared-distance and dot-product comparisons.
+//! Angles (Atan2/Sqrt) are only computed through GetAzimuth/GetElevation once a target is actually detected.
+class AG0_RadarScanFrame
+{
+    vector m_vOrigin;
+    vector m_vForward;      // Horizontal unit forward of the radar
+    vector m_vRight;        // Horizontal unit right of the radar
+    float m_fCosHalfFOV;
+    float m_fCosHalfFOVSq;
+    float m_fRange;
+    float m_fRangeSq;
+    bool m_bFullCircle;
+
+    //------------------------------------------------------------------------------------------------
+    void Update(notnull IEntity owner, float fovDegrees, float range)
+    {
+        vector mat[4];
+        owner.GetTransform(mat);
+
+        m_vOrigin = mat[3];
+
+        vector forwardVec = mat[2];
+        forwardVec[1] = 0; // Project to horizontal plane
+        if (forwardVec.LengthSq() < 0.0001)
+        {
+            // Owner is pitched straight up or down, fall back to the up axis for a heading
+            forwardVec = mat[1];
+            forwardVec[1] = 0;
+        }
+        forwardVec.Normalize();
+
+        m_vForward = forwardVec;
+        m_vRight = Vector(forwardVec[2], 0, -forwardVec[0]);
+
+        m_bFullCircle = fovDegrees >= 360;
+        m_fCosHalfFOV = Math.Cos(fovDegrees * 0.5 * Math.DEG2RAD);
+        m_fCosHalfFOVSq = m_fCosHalfFOV * m_fCosHalfFOV;
+
+        m_fRange = range;
+        m_fRangeSq = range * range;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Horizontal FOV test without normalizing: compares forward·dir against cos(halfFOV)·|dir| in squared form
+    bool IsInFOV(vector relativePos)
+    {
+        if (m_bFullCircle)
+            return true;
+
+        float dx = relativePos[0];
+        float dz = relativePos[2];
+        float horizontalSq = dx * dx + dz * dz;
+        if (horizontalSq < 0.0001)
+            return true; // Directly above or below the antenna
+
+        float forwardDot = dx * m_vForward[0] + dz * m_vForward[2];
+
+        if (m_fCosHalfFOV >= 0)
+            return forwardDot >= 0 && forwardDot * forwardDot >= m_fCosHalfFOVSq * horizontalSq;
+
+        // Wider than 180 degrees: everything in front passes, behind only inside the cone
+        return forwardDot >= 0 || forwardDot * forwardDot <= m_fCosHalfFOVSq * horizontalSq;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Horizontal angle from the radar's forward, clockwise, 0-360 degrees
+    float GetAzimuth(vector relativePos)
+    {
+        float forwardDot = relativePos[0] * m_vForward[0] + relativePos[2] * m_vForward[2];
+        float rightDot = relativePos[0] * m_vRight[0] + relativePos[2] * m_vRight[2];
+
+        float angle = Math.Atan2(rightDot, forwardDot) * Math.RAD2DEG;
+        if (angle < 0)
+            angle += 360;
+
+        return angle;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Vertical angle above the horizontal plane, -90 to 90 degrees
+    float GetElevation(vector relativePos)
+    {
+        float horizontalDistance = Math.Sqrt(relativePos[0] * relativePos[0] + relativePos[2] * relativePos[2]);
+        return Math.Atan2(relativePos[1], horizontalDistance) * Math.RAD2DEG;
+    }
+}
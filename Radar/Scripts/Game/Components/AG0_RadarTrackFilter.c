@@ -0,0 +1,73 @@
+//! Alpha-beta filter over a contact's measured positions, giving a smoothed position and a velocity estimate so the
+//! track can be extrapolated between scans. Positions are relative to the radar, like RadarContact.GetPosition().
+class AG0_RadarTrackFilter
+{
+    protected vector m_vPosition;
+    protected vector m_vVelocity;
+    protected float m_fTime;
+    protected int m_iSamples;
+
+    static const float MIN_STEP = 0.05;            // Measurements closer together in seconds are ignored
+    static const float MAX_EXTRAPOLATION = 10.0;   // Seconds past the last measurement a track is projected at most
+
+    //------------------------------------------------------------------------------------------------
+    void Reset()
+    {
+        m_vVelocity = vector.Zero;
+        m_iSamples = 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Update(vector measured, float time, float alpha, float beta)
+    {
+        if (m_iSamples == 0)
+        {
+            m_vPosition = measured;
+            m_fTime = time;
+            m_iSamples = 1;
+            return;
+        }
+
+        // Ignored rather than half applied, position and time always stay from the same measurement
+        float dt = time - m_fTime;
+        if (dt < MIN_STEP)
+            return;
+
+        // Second sample seeds the velocity directly instead of converging towards it over several scans
+        if (m_iSamples == 1)
+        {
+            m_vVelocity = (measured - m_vPosition) / dt;
+            m_vPosition = measured;
+            m_fTime = time;
+            m_iSamples = 2;
+            return;
+        }
+
+        vector predicted = m_vPosition + m_vVelocity * dt;
+        vector residual = measured - predicted;
+        m_vPosition = predicted + residual * alpha;
+        m_vVelocity = m_vVelocity + residual * (beta / dt);
+        m_fTime = time;
+        m_iSamples++;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    vector Extrapolate(float time)
+    {
+        float dt = Math.Clamp(time - m_fTime, 0, MAX_EXTRAPOLATION);
+        return m_vPosition + m_vVelocity * dt;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! A velocity estimate needs at least two measurements
+    bool HasVelocity()
+    {
+        return m_iSamples >= 2;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    vector GetVelocity()
+    {
+        return m_vVelocity;
+    }
+}
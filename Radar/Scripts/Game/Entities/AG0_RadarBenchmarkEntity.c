@@ -0,0 +1,357 @@
+[EntityEditorProps(category: "GameScripted/Radar", description: "Spawns emitting radars and moving targets and logs radar coverage timings to CSV")]
+class AG0_RadarBenchmarkEntityClass : GenericEntityClass
+{
+}
+
+//! Radar coverage scaling benchmark.
+//! Runs every combination of m_aRadarCounts x m_aVehicleCounts in turn: spawns the radars and targets around the entity,
+//! moves targets along circular scripted paths, waits m_fWarmupTime, then writes one CSV row per completed coverage
+//! cycle for m_fScenarioDuration. Columns are every EAG0_RadarStat; the system's own timings (EVALUATE_MS, CONTACTS_MS,
+//! FRAME_MAX_MS) measure the script work, the server frame time is left out as it only shows the FPS cap.
+//! Runs on the server only, so it works headless, e.g. ArmaReforgerServer -server worlds/radar_benchmark.ent -addons Radar
+class AG0_RadarBenchmarkEntity : GenericEntity
+{
+    [Attribute("{A3C5E2F1B7D94E60}Prefabs/Radar/RadarBenchmarkEmitter.et", UIWidgets.ResourceNamePicker, "Prefab with an AG0_RadarRecieverTransmitterComponent spawned as emitting radar", "et")]
+    protected ResourceName m_sRadarPrefab;
+
+    [Attribute("", UIWidgets.ResourceNamePicker, "Prefab moved along the target paths. Empty spawns bare targets without physics, keeping harness cost out of the measurement", "et")]
+    protected ResourceName m_sVehiclePrefab;
+
+    [Attribute(desc: "Number of emitting radars per scenario")]
+    protected ref array<int> m_aRadarCounts;
+
+    [Attribute(desc: "Number of moving targets per scenario")]
+    protected ref array<int> m_aVehicleCounts;
+
+    [Attribute("1500", UIWidgets.EditBox, "Radius in meters around the entity that radars and target paths are placed in")]
+    protected float m_fAreaRadius;
+
+    [Attribute("10", UIWidgets.EditBox, "Height in meters of radar antennas above terrain")]
+    protected float m_fMastHeight;
+
+    [Attribute("0.3", UIWidgets.Slider, "Fraction of targets flying between 100 and 500 m above terrain", "0 1 0.05")]
+    protected float m_fAirborneFraction;
+
+    [Attribute("15", UIWidgets.EditBox, "Average target speed in m/s")]
+    protected float m_fTargetSpeed;
+
+    [Attribute("10", UIWidgets.EditBox, "Seconds each scenario runs before it is measured")]
+    protected float m_fWarmupTime;
+
+    [Attribute("60", UIWidgets.EditBox, "Seconds measured per scenario")]
+    protected float m_fScenarioDuration;
+
+    [Attribute("$profile:radar_benchmark.csv", UIWidgets.EditBox, "CSV output file")]
+    protected string m_sOutputPath;
+
+    [Attribute("1", desc: "Close the game once every scenario ran")]
+    protected bool m_bQuitWhenDone;
+
+    [Attribute("12345", UIWidgets.EditBox, "Random seed for placement, so runs are comparable")]
+    protected int m_iSeed;
+
+    protected ref RandomGenerator m_Random;
+    protected FileHandle m_File;
+
+    protected int m_iScenario = -1;
+    protected float m_fScenarioTime;
+
+    protected ref array<IEntity> m_aRadars = {};
+    protected ref array<IEntity> m_aTargets = {};
+
+    // Circular path per target: center X/Z, radius, angular speed, phase, height above terrain
+    protected ref array<float> m_aPathCenterX = {};
+    protected ref array<float> m_aPathCenterZ = {};
+    protected ref array<float> m_aPathRadius = {};
+    protected ref array<float> m_aPathOmega = {};
+    protected ref array<float> m_aPathPhase = {};
+    protected ref array<float> m_aPathHeight = {};
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarBenchmarkEntity(IEntitySource src, IEntity parent)
+    {
+        SetEventMask(EntityEvent.INIT);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    override void EOnInit(IEntity owner)
+    {
+        if (!Replication.IsServer())
+            return;
+
+        if (!m_aRadarCounts || m_aRadarCounts.IsEmpty())
+            m_aRadarCounts = {4, 16, 64};
+
+        if (!m_aVehicleCounts || m_aVehicleCounts.IsEmpty())
+            m_aVehicleCounts = {50, 200, 1000};
+
+        AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+        if (!radarSystem)
+        {
+            Print("AG0_RadarBenchmarkEntity: AG0_RadarCoverageSystem is not running, benchmark disabled", LogLevel.ERROR);
+            return;
+        }
+
+        m_File = FileIO.OpenFile(m_sOutputPath, FileMode.WRITE);
+        if (!m_File)
+        {
+            Print("AG0_RadarBenchmarkEntity: cannot open " + m_sOutputPath + ", benchmark disabled", LogLevel.ERROR);
+            return;
+        }
+
+        WriteHeader();
+
+        m_Random = new RandomGenerator();
+        radarSystem.GetOnCoverageCycleCompleted().Insert(OnCoverageCycleCompleted);
+
+        SetEventMask(EntityEvent.FRAME);
+        StartScenario(0);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    override void EOnFrame(IEntity owner, float timeSlice)
+    {
+        if (m_iScenario < 0)
+            return;
+
+        m_fScenarioTime += timeSlice;
+
+        MoveTargets();
+
+        if (m_fScenarioTime >= m_fWarmupTime + m_fScenarioDuration)
+            StartScenario(m_iScenario + 1);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void StartScenario(int scenario)
+    {
+        ClearScenario();
+
+        if (scenario >= m_aRadarCounts.Count() * m_aVehicleCounts.Count())
+        {
+            Finish();
+            return;
+        }
+
+        m_iScenario = scenario;
+        m_fScenarioTime = 0;
+        m_Random.SetSeed(m_iSeed + scenario);
+
+        int radarCount = GetScenarioRadarCount();
+        int targetCount = GetScenarioVehicleCount();
+        Print(string.Format("AG0_RadarBenchmarkEntity: scenario %1, %2 radars x %3 targets", scenario, radarCount, targetCount));
+
+        SpawnRadars(radarCount);
+        SpawnTargets(targetCount);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected int GetScenarioRadarCount()
+    {
+        return m_aRadarCounts[m_iScenario / m_aVehicleCounts.Count()];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected int GetScenarioVehicleCount()
+    {
+        return m_aVehicleCounts[m_iScenario % m_aVehicleCounts.Count()];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void SpawnRadars(int count)
+    {
+        Resource resource = Resource.Load(m_sRadarPrefab);
+        if (!resource.IsValid())
+        {
+            Print("AG0_RadarBenchmarkEntity: invalid radar prefab " + m_sRadarPrefab, LogLevel.ERROR);
+            return;
+        }
+
+        BaseWorld world = GetWorld();
+        vector center = GetOrigin();
+        EntitySpawnParams params = new EntitySpawnParams();
+        params.TransformMode = ETransformMode.WORLD;
+
+        for (int i = 0; i < count; i++)
+        {
+            vector pos = m_Random.GenerateRandomPointInRadius(0, m_fAreaRadius, center, false);
+            pos[1] = world.GetSurfaceY(pos[0], pos[2]) + m_fMastHeight;
+            params.Transform[3] = pos;
+
+            IEntity radarEntity = GetGame().SpawnEntityPrefab(resource, world, params);
+            if (!radarEntity)
+                continue;
+
+            m_aRadars.Insert(radarEntity);
+
+            AG0_RadarRecieverTransmitterComponent radar = AG0_RadarRecieverTransmitterComponent.Cast(radarEntity.FindComponent(AG0_RadarRecieverTransmitterComponent));
+            if (radar)
+                radar.SetEmitting(true);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void SpawnTargets(int count)
+    {
+        Resource resource;
+        if (!m_sVehiclePrefab.IsEmpty())
+            resource = Resource.Load(m_sVehiclePrefab);
+
+        AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+        BaseWorld world = GetWorld();
+        vector center = GetOrigin();
+        EntitySpawnParams params = new EntitySpawnParams();
+        params.TransformMode = ETransformMode.WORLD;
+
+        for (int i = 0; i < count; i++)
+        {
+            vector pathCenter = m_Random.GenerateRandomPointInRadius(0, m_fAreaRadius, center, false);
+            float radius = m_Random.RandFloatXY(50, 500);
+            float speed = m_fTargetSpeed * m_Random.RandFloatXY(0, 2);
+
+            float height = 1;
+            if (m_Random.RandFloat01() < m_fAirborneFraction)
+                height = m_Random.RandFloatXY(100, 500);
+
+            m_aPathCenterX.Insert(pathCenter[0]);
+            m_aPathCenterZ.Insert(pathCenter[2]);
+            m_aPathRadius.Insert(radius);
+            m_aPathOmega.Insert(speed / radius);
+            m_aPathPhase.Insert(m_Random.RandFloatXY(0, Math.PI2));
+            m_aPathHeight.Insert(height);
+
+            params.Transform[3] = GetPathPosition(world, m_aPathCenterX.Count() - 1, 0);
+
+            IEntity target;
+            if (resource && resource.IsValid())
+                target = GetGame().SpawnEntityPrefab(resource, world, params);
+            else
+                target = GetGame().SpawnEntity(GenericEntity, world, params);
+
+            if (!target)
+                continue;
+
+            m_aTargets.Insert(target);
+
+            // Bare targets are not editable entities, so register them with the coverage system directly
+            if (radarSystem)
+                radarSystem.RegisterVehicle(target);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected vector GetPathPosition(BaseWorld world, int index, float time)
+    {
+        float angle = m_aPathPhase[index] + m_aPathOmega[index] * time;
+        float x = m_aPathCenterX[index] + Math.Sin(angle) * m_aPathRadius[index];
+        float z = m_aPathCenterZ[index] + Math.Cos(angle) * m_aPathRadius[index];
+        return Vector(x, world.GetSurfaceY(x, z) + m_aPathHeight[index], z);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void MoveTargets()
+    {
+        BaseWorld world = GetWorld();
+        foreach (int i, IEntity target : m_aTargets)
+        {
+            if (target)
+                target.SetOrigin(GetPathPosition(world, i, m_fScenarioTime));
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void ClearScenario()
+    {
+        AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+
+        foreach (IEntity target : m_aTargets)
+        {
+            if (!target)
+                continue;
+
+            if (radarSystem)
+                radarSystem.UnregisterVehicle(target);
+
+            SCR_EntityHelper.DeleteEntityAndChildren(target);
+        }
+
+        foreach (IEntity radarEntity : m_aRadars)
+        {
+            if (radarEntity)
+                SCR_EntityHelper.DeleteEntityAndChildren(radarEntity);
+        }
+
+        m_aTargets.Clear();
+        m_aRadars.Clear();
+        m_aPathCenterX.Clear();
+        m_aPathCenterZ.Clear();
+        m_aPathRadius.Clear();
+        m_aPathOmega.Clear();
+        m_aPathPhase.Clear();
+        m_aPathHeight.Clear();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void WriteHeader()
+    {
+        string header = "scenario,radars,vehicles,time_s";
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            header += "," + typename.EnumToString(EAG0_RadarStat, i).ToLower();
+        }
+
+        m_File.WriteLine(header);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void OnCoverageCycleCompleted(AG0_RadarCoverageStats stats)
+    {
+        if (m_iScenario < 0 || !m_File)
+            return;
+
+        if (m_fScenarioTime < m_fWarmupTime)
+            return;
+
+        string row = string.Format("%1,%2,%3,%4", m_iScenario, GetScenarioRadarCount(), GetScenarioVehicleCount(),
+            (m_fScenarioTime - m_fWarmupTime).ToString(-1, 2));
+
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            row += "," + stats.GetLast(i).ToString(-1, 2);
+        }
+
+        m_File.WriteLine(row);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void Finish()
+    {
+        m_iScenario = -1;
+        ClearEventMask(EntityEvent.FRAME);
+
+        AG0_RadarCoverageSystem radarSystem = AG0_RadarCoverageSystem.GetInstance();
+        if (radarSystem)
+            radarSystem.GetOnCoverageCycleCompleted().Remove(OnCoverageCycleCompleted);
+
+        if (m_File)
+        {
+            m_File.Close();
+            m_File = null;
+        }
+
+        Print("AG0_RadarBenchmarkEntity: all scenarios done, results in " + m_sOutputPath);
+
+        if (m_bQuitWhenDone)
+            GetGame().RequestClose();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void ~AG0_RadarBenchmarkEntity()
+    {
+        if (m_iScenario >= 0)
+            ClearScenario();
+
+        if (m_File)
+            m_File.Close();
+    }
+}
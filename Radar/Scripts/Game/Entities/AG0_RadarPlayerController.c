@@ -0,0 +1,27 @@
+modded class SCR_PlayerController
+{
+    //------------------------------------------------------------------------------------------------
+    //! Server side: delivers a radar contact delta to this controller's client, see AG0_RadarContactReplicator
+    void AG0_SendRadarContactDelta(RplId radarId, bool reset, array<int> updates, array<int> removals)
+    {
+        Rpc(RpcDo_AG0_RadarContactDelta, radarId, reset, updates, removals);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Reliable: the server only sends deltas against what it believes the client holds
+    [RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+    protected void RpcDo_AG0_RadarContactDelta(RplId radarId, bool reset, array<int> updates, array<int> removals)
+    {
+        RplComponent rpl = RplComponent.Cast(Replication.FindItem(radarId));
+        if (!rpl)
+            return;
+
+        IEntity radarEntity = rpl.GetEntity();
+        if (!radarEntity)
+            return;
+
+        AG0_RadarRecieverTransmitterComponent radar = AG0_RadarRecieverTransmitterComponent.Cast(radarEntity.FindComponent(AG0_RadarRecieverTransmitterComponent));
+        if (radar)
+            radar.ApplyContactDelta(reset, updates, removals);
+    }
+}
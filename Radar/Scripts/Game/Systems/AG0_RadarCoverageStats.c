@@ -0,0 +1,165 @@
+//! Counters recorded by AG0_RadarCoverageSystem for every coverage cycle
+enum EAG0_RadarStat
+{
+    RADARS_SCANNED,         // Emitting radars in the cycle
+    VEHICLES_CONSIDERED,    // Registered vehicles binned into the grid
+    PAIRS,                  // Radar/vehicle pairs queued for evaluation
+    PAIRS_SWEEP_SKIPPED,    // Candidates of sweeping radars outside this cycle's beam sector, never paired
+    PAIRS_RANGE_CULLED,
+    PAIRS_FOV_CULLED,
+    PAIRS_MTI_CULLED,       // Targets too slow for the radar's moving target indication
+    PAIRS_LOD_SKIPPED,      // Known contacts not yet due for re-detection
+    PAIRS_TERRAIN_CULLED,
+    LOS_TRACES,
+    LOS_CACHE_HITS,
+    LOS_SHARED,             // Line of sight requests answered by another pair's trace in the same cycle
+    DETECTIONS,
+    NOTIFICATIONS,          // Receivers painted
+    NETWORK_TRACKS,         // Fused tracks over all IFF networks at cycle end
+    CONTACT_UPDATES,        // Radars whose contact list was maintained
+    SETUP_MS,               // Registry upkeep, grid rebuild and pair list
+    EVALUATE_MS,            // Pair evaluation, summed over every frame of the cycle
+    CONTACTS_MS,            // Batched contact maintenance and horizon mask baking, summed over every frame of the cycle
+    FRAME_MAX_MS,           // Most expensive single frame of the cycle
+    CYCLE_MS,               // Wall time from cycle start to the last pair
+    LAST                    // Not a stat, number of stats
+}
+
+//! Per-cycle performance counters with a rolling window of the last N cycles.
+//! Timings come from System.GetTickCount() and therefore have millisecond resolution; the window average
+//! is still meaningful because the truncation error does not accumulate in one direction.
+class AG0_RadarCoverageStats
+{
+    protected int m_iWindowSize;
+    protected ref array<float> m_aCurrent = {};
+    protected ref array<float> m_aHistory = {};  // Ring buffer, [sample * EAG0_RadarStat.LAST + stat]
+    protected int m_iHistoryHead;
+    protected int m_iHistoryCount;
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarCoverageStats(int windowSize)
+    {
+        m_iWindowSize = Math.Max(windowSize, 1);
+        m_aCurrent.Resize(EAG0_RadarStat.LAST);
+        m_aHistory.Resize(m_iWindowSize * EAG0_RadarStat.LAST);
+        Reset();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Reset()
+    {
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            m_aCurrent[i] = 0;
+        }
+
+        m_iHistoryHead = 0;
+        m_iHistoryCount = 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Add(EAG0_RadarStat stat, float amount = 1)
+    {
+        m_aCurrent[stat] = m_aCurrent[stat] + amount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Max(EAG0_RadarStat stat, float value)
+    {
+        if (value > m_aCurrent[stat])
+            m_aCurrent[stat] = value;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Closes the current cycle: moves its counters into the window and starts a fresh sample
+    void CommitCycle()
+    {
+        int offset = m_iHistoryHead * EAG0_RadarStat.LAST;
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            m_aHistory[offset + i] = m_aCurrent[i];
+            m_aCurrent[i] = 0;
+        }
+
+        m_iHistoryHead = (m_iHistoryHead + 1) % m_iWindowSize;
+        if (m_iHistoryCount < m_iWindowSize)
+            m_iHistoryCount++;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetSampleCount()
+    {
+        return m_iHistoryCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Value of the most recently completed cycle
+    float GetLast(EAG0_RadarStat stat)
+    {
+        if (m_iHistoryCount == 0)
+            return 0;
+
+        int sample = (m_iHistoryHead - 1 + m_iWindowSize) % m_iWindowSize;
+        return m_aHistory[sample * EAG0_RadarStat.LAST + stat];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetMin(EAG0_RadarStat stat)
+    {
+        if (m_iHistoryCount == 0)
+            return 0;
+
+        float result = float.MAX;
+        for (int i = 0; i < m_iHistoryCount; i++)
+        {
+            result = Math.Min(result, m_aHistory[i * EAG0_RadarStat.LAST + stat]);
+        }
+
+        return result;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetAvg(EAG0_RadarStat stat)
+    {
+        if (m_iHistoryCount == 0)
+            return 0;
+
+        float sum;
+        for (int i = 0; i < m_iHistoryCount; i++)
+        {
+            sum += m_aHistory[i * EAG0_RadarStat.LAST + stat];
+        }
+
+        return sum / m_iHistoryCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetMax(EAG0_RadarStat stat)
+    {
+        if (m_iHistoryCount == 0)
+            return 0;
+
+        float result = -float.MAX;
+        for (int i = 0; i < m_iHistoryCount; i++)
+        {
+            result = Math.Max(result, m_aHistory[i * EAG0_RadarStat.LAST + stat]);
+        }
+
+        return result;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! One line per stat: name last / min / avg / max over the window
+    string FormatSummary()
+    {
+        string summary = "Radar coverage over " + m_iHistoryCount + " cycles (last / min / avg / max)";
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            summary += string.Format("\n%1: %2 / %3 / %4 / %5",
+                typename.EnumToString(EAG0_RadarStat, i),
+                GetLast(i).ToString(-1, 1), GetMin(i).ToString(-1, 1), GetAvg(i).ToString(-1, 1), GetMax(i).ToString(-1, 1));
+        }
+
+        return summary;
+    }
+}
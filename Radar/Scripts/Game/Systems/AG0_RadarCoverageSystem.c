@@ -6,9 +6,72 @@
 class AG0_RadarCoverageSystem : GameSystem
 {
     protected ref array<AG0_RadarRecieverTransmitterComponent> m_aRadarComponents = {};
+    protected ref array<AG0_RadarRecieverTransmitterComponent> m_aActiveEmitters = {}; // Kept by OnEmitterStateChanged; the system sleeps while it is empty
     protected ref array<IEntity> m_aVehicles = {};
+    protected ref array<SCR_EditableEntityComponent> m_aVehicleEditables = {}; // Parallel to m_aVehicles
+    protected ref array<AG0_RadarRecieverTransmitterComponent> m_aVehicleReceivers = {}; // Parallel to m_aVehicles, looked up once at registration
     
-    protected static const float UPDATE_INTERVAL = 1.0; // Update every 1 second
+    // Kinematics snapshot, parallel to m_aVehicles and refreshed once per coverage cycle so radars never query the vehicles themselves
+    protected ref array<vector> m_aVehiclePositions = {};
+    protected ref array<vector> m_aVehicleVelocities = {};     // From the previous snapshot, zero until a vehicle was sampled twice
+    protected ref array<float> m_aVehicleSampleTimes = {};     // 0 when never sampled
+    protected ref array<ERadarCrossSection> m_aVehicleCrossSections = {};
+    protected ref map<ResourceName, ERadarCrossSection> m_mPrefabCrossSections = new map<ResourceName, ERadarCrossSection>(); // Resolved once per prefab
+    protected bool m_bVehicleListDirty;
+    protected bool m_bVehicleRegistryHooked;
+    
+    [Attribute("500", UIWidgets.EditBox, "Size in meters of one spatial grid cell used to find vehicles near a radar")]
+    protected float m_fGridCellSize;
+    
+    protected ref AG0_RadarSpatialGrid m_VehicleGrid;
+    protected ref array<int> m_aCandidateIndices = {};
+    
+    [Attribute("1.0", UIWidgets.EditBox, "Seconds in which every emitting radar/vehicle pair is evaluated once")]
+    protected float m_fCoverageInterval;
+    
+    [Attribute("64", UIWidgets.EditBox, "Maximum radar/vehicle pairs evaluated per frame")]
+    protected int m_iMaxPairsPerFrame;
+    
+    [Attribute("8", UIWidgets.EditBox, "Maximum line of sight traces issued per frame")]
+    protected int m_iMaxTracesPerFrame;
+    
+    [Attribute("2.0", UIWidgets.EditBox, "Size in meters of the cells both ends of a line of sight request are snapped to; requests with matching cells share one trace")]
+    protected float m_fLOSShareCellSize;
+    
+    protected ref AG0_RadarLOSQueue m_LOSQueue;
+    
+    [Attribute("2000", UIWidgets.EditBox, "Maximum terrain height queries per frame spent baking horizon masks of static radars")]
+    protected int m_iHorizonSamplesPerFrame;
+    
+    protected ref array<AG0_RadarRecieverTransmitterComponent> m_aHorizonBakes = {}; // Radars waiting for their horizon mask, in request order
+    
+    // Work for the coverage cycle in progress. Radars and their frames are captured when the cycle begins,
+    // pairs are flattened so the per-frame scheduler only has to advance a single cursor.
+    protected ref array<AG0_RadarRecieverTransmitterComponent> m_aCycleRadars = {};
+    protected ref array<AG0_RadarScanFrame> m_aCycleFrames = {};
+    protected ref array<int> m_aPairRadarIndices = {};
+    protected ref array<int> m_aPairVehicleIndices = {};
+    protected ref array<int> m_aSweepCandidates = {};   // Scratch for sweep sector bucketing, pairs of vehicle index and bucket
+    protected ref array<int> m_aSweepBucketStarts = {};
+    protected int m_iPairCursor;
+    protected int m_iCycleIndex;
+    protected float m_fCycleStartTime;
+    protected bool m_bCycleActive;
+    
+    [Attribute("60", UIWidgets.EditBox, "Number of completed coverage cycles kept for min/avg/max statistics")]
+    protected int m_iStatsWindow;
+    
+    [Attribute("0", UIWidgets.EditBox, "Seconds between coverage statistics reports in the log, 0 disables")]
+    protected float m_fStatsReportInterval;
+    
+    protected ref map<int, ref AG0_RadarTrackPicture> m_mTrackPictures = new map<int, ref AG0_RadarTrackPicture>(); // By IFF key
+    
+    protected ref AG0_RadarCoverageStats m_Stats;
+    protected float m_fLastStatsReportTime;
+    protected ref ScriptInvoker m_OnCoverageCycleCompleted;
+    
+    protected static const float CYCLE_SPREAD = 0.9; // Fraction of the interval the pairs are spread over, leaving headroom for slow frames
+    protected static const float MAX_VELOCITY_SAMPLE_INTERVALS = 3; // Coverage intervals between snapshots beyond which no velocity is derived
     
     //------------------------------------------------------------------------------------------------
 	
@@ -30,15 +93,32 @@ class AG0_RadarCoverageSystem : GameSystem
     override void OnStarted()
 	{
 	    super.OnStarted();
-	    Print("AG0_RadarCoverageSystem OnStarted called");
-	    GetGame().GetCallqueue().CallLater(UpdateRadarCoverage, UPDATE_INTERVAL * 1000, true);
+#ifdef ENABLE_DIAG
+	    if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+	        AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "AG0_RadarCoverageSystem OnStarted called", LogLevel.NORMAL);
+	    
+	    AG0_RadarLog.RegisterDiagMenu();
+	    DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_SHOW_STATS, "", "Show coverage stats", "Radar");
+#endif
+	    m_VehicleGrid = new AG0_RadarSpatialGrid(m_fGridCellSize);
+	    m_Stats = new AG0_RadarCoverageStats(m_iStatsWindow);
+	    m_LOSQueue = new AG0_RadarLOSQueue();
+	    m_LOSQueue.SetCellSize(m_fLOSShareCellSize);
+	    HookVehicleRegistry();
+	    m_fCycleStartTime = System.GetTickCount() / 1000.0;
+	    m_bCycleActive = false;
 	}
     
     //------------------------------------------------------------------------------------------------
     override void OnStopped()
     {
         super.OnStopped();
-        GetGame().GetCallqueue().Remove(UpdateRadarCoverage);
+#ifdef ENABLE_DIAG
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_SHOW_STATS);
+        AG0_RadarLog.UnregisterDiagMenu();
+#endif
+        UnhookVehicleRegistry();
+        m_bCycleActive = false;
         s_Instance = null;
     }
     
@@ -53,82 +133,780 @@ class AG0_RadarCoverageSystem : GameSystem
     void UnregisterRadarComponent(AG0_RadarRecieverTransmitterComponent component)
     {
         m_aRadarComponents.RemoveItem(component);
+        m_aActiveEmitters.RemoveItem(component);
+        m_aHorizonBakes.RemoveItem(component);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! The radar's horizon mask is baked over the next frames within m_iHorizonSamplesPerFrame
+    void QueueHorizonBake(notnull AG0_RadarRecieverTransmitterComponent radar)
+    {
+        if (!m_aHorizonBakes.Contains(radar))
+            m_aHorizonBakes.Insert(radar);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Works off queued horizon bakes oldest first. Radars that stopped emitting are dropped and resume when they start again.
+    protected void UpdateHorizonBakes()
+    {
+        int budget = m_iHorizonSamplesPerFrame;
+        while (budget > 0 && !m_aHorizonBakes.IsEmpty())
+        {
+            AG0_RadarRecieverTransmitterComponent radar = m_aHorizonBakes[0];
+            if (radar && radar.IsEmitting())
+                budget -= radar.ContinueHorizonBake(budget);
+            
+            if (!radar || !radar.IsEmitting() || !radar.IsHorizonMaskPending())
+                m_aHorizonBakes.RemoveOrdered(0);
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Called by the radar whenever its emission state was set. Wakes the system when the first emitter turns on,
+    //! turning the last one off lets the system run down its contacts and then sleep.
+    void OnEmitterStateChanged(notnull AG0_RadarRecieverTransmitterComponent radar)
+    {
+        if (!radar.IsEmitting())
+        {
+            m_aActiveEmitters.RemoveItem(radar);
+            return;
+        }
+        
+        if (m_aActiveEmitters.Contains(radar))
+            return;
+        
+        m_aActiveEmitters.Insert(radar);
+        if (m_aActiveEmitters.Count() == 1)
+            Wake();
     }
     
     //------------------------------------------------------------------------------------------------
-    protected void UpdateRadarCoverage()
+    //! Makes a coverage cycle due on the very next frame, resuming ticking if the system was asleep.
+    //! Also needed while still awake expiring contacts, as the idle branch of OnUpdate keeps pushing the cycle start.
+    protected void Wake()
     {
-        Print("UpdateRadarCoverage called. Active radar components: " + m_aRadarComponents.Count());
+        if (!m_bCycleActive)
+            m_fCycleStartTime = System.GetTickCount() / 1000.0 - m_fCoverageInterval;
         
-        UpdateVehicleList();
-        Print("Vehicles updated. Total vehicles: " + m_aVehicles.Count());
+        if (IsEnabled())
+            return;
+        
+        Enable(true);
         
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "Radar emitting, coverage system woken", LogLevel.NORMAL);
+#endif
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Stops ticking until the next emitter turns on
+    protected void Sleep()
+    {
+        Enable(false);
+        
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "No radar emitting and no contacts left, coverage system sleeping", LogLevel.NORMAL);
+#endif
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! True while any radar still has contacts to expire or removals to replicate, or a network still has tracks
+    protected bool HasPendingContactWork()
+    {
         foreach (AG0_RadarRecieverTransmitterComponent radar : m_aRadarComponents)
-	    {
-	        if (radar.IsEmitting())
-	        {
-	            vector radarPos = radar.GetOwner().GetOrigin();
-	            vector ownerOrientation = radar.GetOwner().GetAngles();
-	            float maxRange = radar.GetMaxRange();
-	            
-	            foreach (IEntity vehicle : m_aVehicles)
-	            {
-	                vector vehiclePos = vehicle.GetOrigin();
-	                vector relativePos = vehiclePos - radarPos;
-	                float distance = relativePos.Length();
-	                
-	                if (distance < 0.01)
-	                {
-	                    Print("Warning: Very small distance detected between radar and vehicle: " + distance);
-	                    continue; // Skip this vehicle to avoid potential issues
-	                }
-	
-	                if (radar.IsEntityInFOV(vehicle, ownerOrientation))
-	                {
-	                    if (distance <= maxRange && radar.IsInLineOfSight(vehicle))
-	                    {
-	                        float detectionStrength = radar.CalculateDetectionStrength(distance);
-	                        if (detectionStrength > radar.GetEffectiveDetectionThreshold())
-	                        {
-	                            radar.AddDetectedEntity(vehicle, relativePos);
-	                            float angle = radar.CalculateRelativeAngleTo(vehicle);
-	                            NotifyDetectedEntity(vehicle, angle, detectionStrength, radar.GetIFFKey());
-	                        }
-	                    }
-	                }
-	            }
-	        }
-	    }
+        {
+            if (radar && radar.HasPendingContactWork())
+                return true;
+        }
+        
+        for (int i = 0; i < m_mTrackPictures.Count(); i++)
+        {
+            if (m_mTrackPictures.GetElement(i).Count() > 0)
+                return true;
+        }
+        
+        return false;
+    }
+    
+#ifdef ENABLE_DIAG
+    //------------------------------------------------------------------------------------------------
+    override void OnDiag(float timeSlice)
+    {
+        super.OnDiag(timeSlice);
+        
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_SHOW_STATS))
+            DrawStatsOverlay();
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected void DrawStatsOverlay()
+    {
+        DbgUI.Begin("Radar coverage", 0, 0);
+        DbgUI.Text("Cycles in window: " + m_Stats.GetSampleCount() + "   (last / min / avg / max)");
+        for (int i = 0; i < EAG0_RadarStat.LAST; i++)
+        {
+            DbgUI.Text(string.Format("%1: %2 / %3 / %4 / %5",
+                typename.EnumToString(EAG0_RadarStat, i),
+                m_Stats.GetLast(i).ToString(-1, 1), m_Stats.GetMin(i).ToString(-1, 1),
+                m_Stats.GetAvg(i).ToString(-1, 1), m_Stats.GetMax(i).ToString(-1, 1)));
+        }
+        DbgUI.End();
+    }
+#endif
+    
+    //------------------------------------------------------------------------------------------------
+    //! Per-cycle counters with a rolling window, for diagnostics and budget tuning
+    AG0_RadarCoverageStats GetStats()
+    {
+        return m_Stats;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Invoked with the stats object right after a completed cycle was committed to it
+    ScriptInvoker GetOnCoverageCycleCompleted()
+    {
+        if (!m_OnCoverageCycleCompleted)
+            m_OnCoverageCycleCompleted = new ScriptInvoker();
+        
+        return m_OnCoverageCycleCompleted;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Starts a new coverage cycle once the interval has elapsed, then advances the current one by a bounded amount.
+    //! With no radar emitting only contact maintenance runs, until nothing is left to expire and the system sleeps.
+    override void OnUpdate(ESystemPoint point)
+    {
+        super.OnUpdate(point);
+        
+        int frameStartTick = System.GetTickCount();
+        float currentTime = frameStartTick / 1000.0;
+        
+        UpdateContactMaintenance(currentTime);
+        if (!m_aHorizonBakes.IsEmpty())
+            UpdateHorizonBakes();
+        
+        int contactsEndTick = System.GetTickCount();
+        m_Stats.Add(EAG0_RadarStat.CONTACTS_MS, contactsEndTick - frameStartTick);
+        
+        if (!m_bCycleActive)
+        {
+            if (currentTime - m_fCycleStartTime < m_fCoverageInterval)
+                return;
+            
+            if (m_aActiveEmitters.IsEmpty())
+            {
+                m_fCycleStartTime = currentTime;
+                ExpireTrackPictures(currentTime);
+                if (!HasPendingContactWork())
+                    Sleep();
+                
+                return;
+            }
+            
+            BeginCoverageCycle(currentTime);
+            m_Stats.Add(EAG0_RadarStat.SETUP_MS, System.GetTickCount() - contactsEndTick);
+        }
+        
+        int evaluateStartTick = System.GetTickCount();
+        UpdateRadarCoverage(currentTime);
+        
+        int evaluateEndTick = System.GetTickCount();
+        m_Stats.Add(EAG0_RadarStat.EVALUATE_MS, evaluateEndTick - evaluateStartTick);
+        m_Stats.Max(EAG0_RadarStat.FRAME_MAX_MS, evaluateEndTick - frameStartTick);
+        
+        if (!m_bCycleActive)
+            EndCoverageCycle(evaluateEndTick / 1000.0);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Single batched contact pass over every registered radar, in registration order.
+    //! Each radar keeps its own FOV dependent interval through its next-due time; crew replication can be due in between.
+    protected void UpdateContactMaintenance(float currentTime)
+    {
+        foreach (AG0_RadarRecieverTransmitterComponent radar : m_aRadarComponents)
+        {
+            if (!radar)
+                continue;
+            
+            if (currentTime >= radar.GetNextContactUpdateTime())
+            {
+                radar.UpdateContacts(currentTime);
+                m_Stats.Add(EAG0_RadarStat.CONTACT_UPDATES);
+            }
+            else if (currentTime >= radar.GetNextReplicationTime())
+            {
+                radar.ReplicateContacts(currentTime);
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected void EndCoverageCycle(float currentTime)
+    {
+        m_Stats.Add(EAG0_RadarStat.NETWORK_TRACKS, ExpireTrackPictures(currentTime));
+        
+        m_Stats.Add(EAG0_RadarStat.CYCLE_MS, (currentTime - m_fCycleStartTime) * 1000);
+        m_Stats.CommitCycle();
+        
+        if (m_OnCoverageCycleCompleted)
+            m_OnCoverageCycleCompleted.Invoke(m_Stats);
+        
+        if (m_fStatsReportInterval > 0 && currentTime - m_fLastStatsReportTime >= m_fStatsReportInterval)
+        {
+            m_fLastStatsReportTime = currentTime;
+            Print(m_Stats.FormatSummary());
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Drops stale tracks from every network picture, returns the number of tracks left
+    protected int ExpireTrackPictures(float currentTime)
+    {
+        int trackCount;
+        for (int i = 0; i < m_mTrackPictures.Count(); i++)
+        {
+            AG0_RadarTrackPicture picture = m_mTrackPictures.GetElement(i);
+            picture.ExpireTracks(currentTime);
+            trackCount += picture.Count();
+        }
+        
+        return trackCount;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Snapshots vehicles and emitting radars and flattens every candidate radar/vehicle pair into the work list
+    protected void BeginCoverageCycle(float currentTime)
+    {
+        if (!m_bVehicleRegistryHooked)
+            HookVehicleRegistry();
+        
+        if (m_bVehicleListDirty)
+            CompactVehicleList();
+        
+        RebuildVehicleGrid(currentTime);
+        
+        m_aCycleRadars.Clear();
+        m_aCycleFrames.Clear();
+        m_aPairRadarIndices.Clear();
+        m_aPairVehicleIndices.Clear();
+        
+        foreach (AG0_RadarRecieverTransmitterComponent radar : m_aActiveEmitters)
+        {
+            if (!radar || !radar.IsEmitting())
+                continue;
+            
+            radar.UpdateScanFrame();
+            AG0_RadarScanFrame frame = radar.GetScanFrame();
+            
+            int radarIndex = m_aCycleRadars.Insert(radar);
+            m_aCycleFrames.Insert(frame);
+            
+            // Only vehicles binned into cells overlapping the radar's range circle are considered
+            m_aCandidateIndices.Clear();
+            m_VehicleGrid.Query(frame.m_vOrigin, frame.m_fRange, m_aCandidateIndices);
+            
+            if (radar.IsSweeping())
+            {
+                AppendSweepPairs(radarIndex, radar, frame);
+                continue;
+            }
+            
+            foreach (int vehicleIndex : m_aCandidateIndices)
+            {
+                m_aPairRadarIndices.Insert(radarIndex);
+                m_aPairVehicleIndices.Insert(vehicleIndex);
+            }
+        }
+        
+        m_iPairCursor = 0;
+        m_iCycleIndex++;
+        m_LOSQueue.BeginCycle();
+        m_fCycleStartTime = currentTime;
+        m_bCycleActive = !m_aPairRadarIndices.IsEmpty();
+        
+        m_Stats.Add(EAG0_RadarStat.RADARS_SCANNED, m_aCycleRadars.Count());
+        m_Stats.Add(EAG0_RadarStat.VEHICLES_CONSIDERED, m_VehicleGrid.GetEntryCount());
+        m_Stats.Add(EAG0_RadarStat.PAIRS, m_aPairRadarIndices.Count());
+        
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.COVERAGE, LogLevel.DEBUG))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.COVERAGE, "Coverage cycle started. Emitting radars: " + m_aCycleRadars.Count() + ", vehicles: " + m_aVehicles.Count() + ", pairs: " + m_aPairRadarIndices.Count(), LogLevel.DEBUG);
+#endif
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Pairs a sweeping radar only with the candidates inside the sector its beam passes over this cycle.
+    //! Candidates are bucketed by beam width and appended in sweep order, so as the cycle's pairs are worked off
+    //! detections follow the beam instead of arriving all at once.
+    protected void AppendSweepPairs(int radarIndex, AG0_RadarRecieverTransmitterComponent radar, AG0_RadarScanFrame frame)
+    {
+        float sectorStart;
+        float sectorArc = radar.AdvanceSweep(m_fCoverageInterval, sectorStart);
+        float span = radar.GetSweepSpan();
+        float invBeamWidth = 1 / radar.GetBeamWidth();
+        int bucketCount = Math.Max(Math.Ceil(sectorArc * invBeamWidth), 1);
+        
+        m_aSweepCandidates.Clear();
+        m_aSweepBucketStarts.Clear();
+        m_aSweepBucketStarts.Resize(bucketCount + 1);
+        int bucket;
+        
+        for (bucket = 0; bucket <= bucketCount; bucket++)
+        {
+            m_aSweepBucketStarts[bucket] = 0;
+        }
+        
+        foreach (int vehicleIndex : m_aCandidateIndices)
+        {
+            vector relativePos = m_aVehiclePositions[vehicleIndex] - frame.m_vOrigin;
+            
+            // Offset into the sweep span, 0 at the left edge of a sector radar's field of view
+            float sweepOffset = frame.GetAzimuth(relativePos);
+            if (!frame.m_bFullCircle)
+            {
+                if (sweepOffset > 180)
+                    sweepOffset -= 360;
+                
+                sweepOffset += span * 0.5;
+                if (sweepOffset < 0 || sweepOffset >= span)
+                    continue; // Outside the field of view
+            }
+            
+            float sectorOffset = sweepOffset - sectorStart;
+            if (sectorOffset < 0)
+                sectorOffset += span;
+            
+            if (sectorOffset >= sectorArc)
+            {
+                m_Stats.Add(EAG0_RadarStat.PAIRS_SWEEP_SKIPPED);
+                continue;
+            }
+            
+            bucket = Math.Min(sectorOffset * invBeamWidth, bucketCount - 1);
+            m_aSweepCandidates.Insert(vehicleIndex);
+            m_aSweepCandidates.Insert(bucket);
+            m_aSweepBucketStarts[bucket + 1] = m_aSweepBucketStarts[bucket + 1] + 1;
+        }
+        
+        int candidateCount = m_aSweepCandidates.Count() / 2;
+        if (candidateCount == 0)
+            return;
+        
+        // Counting sort by bucket straight into the pair list
+        for (bucket = 1; bucket <= bucketCount; bucket++)
+        {
+            m_aSweepBucketStarts[bucket] = m_aSweepBucketStarts[bucket] + m_aSweepBucketStarts[bucket - 1];
+        }
+        
+        int firstPair = m_aPairRadarIndices.Count();
+        m_aPairRadarIndices.Resize(firstPair + candidateCount);
+        m_aPairVehicleIndices.Resize(firstPair + candidateCount);
+        
+        for (int i = 0; i < candidateCount; i++)
+        {
+            bucket = m_aSweepCandidates[i * 2 + 1];
+            int pairIndex = firstPair + m_aSweepBucketStarts[bucket];
+            m_aSweepBucketStarts[bucket] = m_aSweepBucketStarts[bucket] + 1;
+            
+            m_aPairRadarIndices[pairIndex] = radarIndex;
+            m_aPairVehicleIndices[pairIndex] = m_aSweepCandidates[i * 2];
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Evaluates the share of the cycle's pairs that is due by now, capped by the per-frame pair and trace budgets.
+    //! If the budgets are too small for the scene the cycle stretches past the interval instead of spiking a frame.
+    //! Pairs that need a trace are queued and traced together at the end, so the trace budget counts unique traces only.
+    protected void UpdateRadarCoverage(float currentTime)
+    {
+        int pairCount = m_aPairRadarIndices.Count();
+        
+        float cycleProgress = (currentTime - m_fCycleStartTime) / (m_fCoverageInterval * CYCLE_SPREAD);
+        int duePairs = Math.Ceil(pairCount * Math.Clamp(cycleProgress, 0, 1));
+        int pairBudget = Math.Min(duePairs - m_iPairCursor, m_iMaxPairsPerFrame);
+        
+        m_LOSQueue.Clear();
+        
+        int pairsDone;
+        while (m_iPairCursor < pairCount && pairsDone < pairBudget && m_LOSQueue.GetTraceCount() < m_iMaxTracesPerFrame)
+        {
+            ProcessCoveragePair(m_iPairCursor, currentTime);
+            m_iPairCursor++;
+            pairsDone++;
+        }
+        
+        ResolveLineOfSightQueue(currentTime);
+        
+        if (m_iPairCursor >= pairCount)
+            m_bCycleActive = false;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Traces every unique queued segment once and hands the result to each pair that asked for it
+    protected void ResolveLineOfSightQueue(float currentTime)
+    {
+        int requestCount = m_LOSQueue.GetRequestCount();
+        if (requestCount == 0)
+            return;
+        
+        m_LOSQueue.Resolve();
+        
+        int traceCount = m_LOSQueue.GetTraceCount();
+        m_Stats.Add(EAG0_RadarStat.LOS_TRACES, traceCount);
+        m_Stats.Add(EAG0_RadarStat.LOS_SHARED, requestCount - traceCount);
+        
+        for (int request = 0; request < requestCount; request++)
+        {
+            int pairIndex = m_LOSQueue.GetRequestTag(request);
+            bool clear = m_LOSQueue.IsRequestClear(request);
+            
+            AG0_RadarRecieverTransmitterComponent radar = m_aCycleRadars[m_aPairRadarIndices[pairIndex]];
+            int vehicleIndex = m_aPairVehicleIndices[pairIndex];
+            IEntity vehicle = m_aVehicles[vehicleIndex];
+            if (!radar || !vehicle)
+                continue;
+            
+            radar.StoreLineOfSight(vehicle, m_aCycleFrames[m_aPairRadarIndices[pairIndex]].m_vOrigin, m_aVehiclePositions[vehicleIndex], clear);
+            
+            if (clear)
+                EvaluateDetection(pairIndex, currentTime);
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Runs the cheap culls of a pair. Pairs left over either complete from the radar's line of sight cache
+    //! or are queued for a trace.
+    protected void ProcessCoveragePair(int pairIndex, float currentTime)
+    {
+        int radarIndex = m_aPairRadarIndices[pairIndex];
+        AG0_RadarRecieverTransmitterComponent radar = m_aCycleRadars[radarIndex];
+        if (!radar || !radar.IsEmitting())
+            return;
+        
+        int vehicleIndex = m_aPairVehicleIndices[pairIndex];
+        IEntity vehicle = m_aVehicles[vehicleIndex];
+        if (!vehicle)
+            return;
+        
+        AG0_RadarScanFrame frame = m_aCycleFrames[radarIndex];
+        vector vehiclePos = m_aVehiclePositions[vehicleIndex];
+        vector relativePos = vehiclePos - frame.m_vOrigin;
+        float distanceSq = relativePos.LengthSq();
+        
+        if (distanceSq < 0.0001)
+        {
+#ifdef ENABLE_DIAG
+            if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.COVERAGE, LogLevel.DEBUG))
+                AG0_RadarLog.Log(EAG0_RadarLogCategory.COVERAGE, "Very small distance detected between radar and vehicle: " + Math.Sqrt(distanceSq), LogLevel.DEBUG);
+#endif
+            return; // Skip this vehicle to avoid potential issues
+        }
+        
+        // Cheapest rejections first; no square roots or trig until a detection is confirmed.
+        // The range per cross-section already folds in the detection threshold, capped at the radar's maximum range.
+        ERadarCrossSection crossSection = m_aVehicleCrossSections[vehicleIndex];
+        if (distanceSq > radar.GetDetectionRangeSq(crossSection))
+        {
+            m_Stats.Add(EAG0_RadarStat.PAIRS_RANGE_CULLED);
+            return;
+        }
+        
+        if (!frame.IsInFOV(relativePos))
+        {
+            m_Stats.Add(EAG0_RadarStat.PAIRS_FOV_CULLED);
+            return;
+        }
+        
+        // Moving target indication uses the snapshot velocity, so parked vehicles never reach a trace
+        if (!radar.PassesMovingTargetIndication(relativePos, m_aVehicleVelocities[vehicleIndex], vehiclePos))
+        {
+            m_Stats.Add(EAG0_RadarStat.PAIRS_MTI_CULLED);
+            return;
+        }
+        
+        // Known contact that is still fresh for its level of detail: skip terrain and line of sight,
+        // but keep painting the receiver so its RWR does not fade between re-detections
+        if (!radar.IsRedetectionDue(vehicle, currentTime))
+        {
+            m_Stats.Add(EAG0_RadarStat.PAIRS_LOD_SKIPPED);
+            NotifyDetectedEntity(m_aVehicleReceivers[vehicleIndex], radar, frame.GetAzimuth(relativePos), radar.CalculateDetectionStrengthSq(distanceSq));
+            return;
+        }
+        
+        if (radar.IsTerrainMasked(frame.m_vOrigin, vehiclePos))
+        {
+            m_Stats.Add(EAG0_RadarStat.PAIRS_TERRAIN_CULLED);
+            return;
+        }
+        
+        bool clear;
+        if (radar.GetCachedLineOfSight(vehicle, frame.m_vOrigin, vehiclePos, clear))
+        {
+            m_Stats.Add(EAG0_RadarStat.LOS_CACHE_HITS);
+        }
+        else if (m_LOSQueue.FindCycleResult(frame.m_vOrigin, vehiclePos, clear))
+        {
+            // Traced for another pair earlier this cycle, e.g. the reverse direction or a co-located radar
+            m_Stats.Add(EAG0_RadarStat.LOS_SHARED);
+            radar.StoreLineOfSight(vehicle, frame.m_vOrigin, vehiclePos, clear);
+        }
+        else
+        {
+            m_LOSQueue.Request(pairIndex, radar, vehicle, frame.m_vOrigin, vehiclePos);
+            return;
+        }
+        
+        if (clear)
+            EvaluateDetection(pairIndex, currentTime);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Detection strength test and bookkeeping for a pair with clear line of sight
+    protected void EvaluateDetection(int pairIndex, float currentTime)
+    {
+        int radarIndex = m_aPairRadarIndices[pairIndex];
+        AG0_RadarRecieverTransmitterComponent radar = m_aCycleRadars[radarIndex];
+        int vehicleIndex = m_aPairVehicleIndices[pairIndex];
+        IEntity vehicle = m_aVehicles[vehicleIndex];
+        
+        AG0_RadarScanFrame frame = m_aCycleFrames[radarIndex];
+        vector vehiclePos = m_aVehiclePositions[vehicleIndex];
+        vector relativePos = vehiclePos - frame.m_vOrigin;
+        float distanceSq = relativePos.LengthSq();
+        
+        // The echo scales with the target's cross-section, the emission its RWR receives does not
+        float paintStrength = radar.CalculateDetectionStrengthSq(distanceSq);
+        float crossSectionFactor = AG0_RadarRecieverTransmitterComponent.GetCrossSectionFactor(m_aVehicleCrossSections[vehicleIndex]);
+        if (paintStrength * crossSectionFactor > radar.GetEffectiveDetectionThreshold())
+        {
+            m_Stats.Add(EAG0_RadarStat.DETECTIONS);
+            float azimuth = frame.GetAzimuth(relativePos);
+            
+            // Radars feeding their network keep no contacts of their own, the others do not feed the network
+            if (radar.UsesNetworkPicture())
+                GetOrCreateTrackPicture(radar.GetIFFKey()).Contribute(vehicle, vehiclePos, Math.Sqrt(distanceSq), radar, currentTime, m_iCycleIndex);
+            else
+                radar.AddDetectedContact(vehicle, relativePos, azimuth, frame.GetElevation(relativePos));
+            
+            NotifyDetectedEntity(m_aVehicleReceivers[vehicleIndex], radar, azimuth, paintStrength);
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Fused track picture of all radars using the network picture with iffKey, null until one of them detected something
+    AG0_RadarTrackPicture GetTrackPicture(int iffKey)
+    {
+        return m_mTrackPictures.Get(iffKey);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected AG0_RadarTrackPicture GetOrCreateTrackPicture(int iffKey)
+    {
+        AG0_RadarTrackPicture picture = m_mTrackPictures.Get(iffKey);
+        if (!picture)
+        {
+            picture = new AG0_RadarTrackPicture(iffKey);
+            m_mTrackPictures.Insert(iffKey, picture);
+        }
+        
+        return picture;
     }
     
     //------------------------------------------------------------------------------------------------
-    protected void UpdateVehicleList()
+    //! Takes the per-cycle kinematics snapshot and bins every known vehicle into the spatial grid.
+    //! This is the only place vehicle positions are read from the engine.
+    protected void RebuildVehicleGrid(float currentTime)
     {
-        m_aVehicles.Clear();
+        m_VehicleGrid.Clear();
         
+        foreach (int i, IEntity vehicle : m_aVehicles)
+        {
+            // Deleted without going through UnregisterVehicle
+            if (!vehicle)
+            {
+                m_bVehicleListDirty = true;
+                continue;
+            }
+            
+            SCR_EditableEntityComponent editable = m_aVehicleEditables[i];
+            if (editable && editable.IsDestroyed())
+            {
+                // Wrecks stop being radar targets; drop them on the next compaction
+                m_aVehicles[i] = null;
+                m_aVehicleEditables[i] = null;
+                m_aVehicleReceivers[i] = null;
+                m_bVehicleListDirty = true;
+                continue;
+            }
+            
+            vector vehiclePos = vehicle.GetOrigin();
+            // Samples further apart than a few intervals (system asleep, long cycle) would average a stop away
+            float sampleGap = currentTime - m_aVehicleSampleTimes[i];
+            if (m_aVehicleSampleTimes[i] > 0 && sampleGap > 0 && sampleGap <= m_fCoverageInterval * MAX_VELOCITY_SAMPLE_INTERVALS)
+                m_aVehicleVelocities[i] = (vehiclePos - m_aVehiclePositions[i]) / sampleGap;
+            else
+                m_aVehicleVelocities[i] = vector.Zero;
+            
+            m_aVehiclePositions[i] = vehiclePos;
+            m_aVehicleSampleTimes[i] = currentTime;
+            m_VehicleGrid.Insert(i, vehiclePos);
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Subscribes to editable entity (un)registration and seeds the registry with vehicles that already exist.
+    //! The full editable entity scan only ever happens here, once.
+    protected void HookVehicleRegistry()
+    {
         SCR_EditableEntityCore core = SCR_EditableEntityCore.Cast(SCR_EditableEntityCore.GetInstance(SCR_EditableEntityCore));
         if (!core)
             return;
         
+        core.Event_OnEntityRegistered.Insert(OnEditableEntityRegistered);
+        core.Event_OnEntityUnregistered.Insert(OnEditableEntityUnregistered);
+        m_bVehicleRegistryHooked = true;
+        
         set<SCR_EditableEntityComponent> entities = new set<SCR_EditableEntityComponent>;
         core.GetAllEntities(entities, true, false);
         
         foreach (SCR_EditableEntityComponent ent : entities)
         {
-            Vehicle vehicle = Vehicle.Cast(ent.GetOwner());
-            if (vehicle && !ent.IsDestroyed())
-                m_aVehicles.Insert(vehicle);
+            OnEditableEntityRegistered(ent);
         }
+        
+#ifdef ENABLE_DIAG
+        if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.SYSTEM, LogLevel.NORMAL))
+            AG0_RadarLog.Log(EAG0_RadarLogCategory.SYSTEM, "AG0_RadarCoverageSystem vehicle registry seeded. Total vehicles: " + m_aVehicles.Count(), LogLevel.NORMAL);
+#endif
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected void UnhookVehicleRegistry()
+    {
+        if (!m_bVehicleRegistryHooked)
+            return;
+        
+        m_bVehicleRegistryHooked = false;
+        
+        SCR_EditableEntityCore core = SCR_EditableEntityCore.Cast(SCR_EditableEntityCore.GetInstance(SCR_EditableEntityCore));
+        if (!core)
+            return;
+        
+        core.Event_OnEntityRegistered.Remove(OnEditableEntityRegistered);
+        core.Event_OnEntityUnregistered.Remove(OnEditableEntityUnregistered);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected void OnEditableEntityRegistered(SCR_EditableEntityComponent ent)
+    {
+        if (!ent || ent.IsDestroyed())
+            return;
+        
+        Vehicle vehicle = Vehicle.Cast(ent.GetOwner());
+        if (vehicle)
+            RegisterVehicle(vehicle, ent);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    protected void OnEditableEntityUnregistered(SCR_EditableEntityComponent ent)
+    {
+        if (!ent)
+            return;
+        
+        Vehicle vehicle = Vehicle.Cast(ent.GetOwner());
+        if (vehicle)
+            UnregisterVehicle(vehicle);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    void RegisterVehicle(IEntity vehicle, SCR_EditableEntityComponent editable = null)
+    {
+        if (!vehicle || m_aVehicles.Contains(vehicle))
+            return;
+        
+        m_aVehicles.Insert(vehicle);
+        m_aVehicleEditables.Insert(editable);
+        m_aVehicleReceivers.Insert(AG0_RadarRecieverTransmitterComponent.Cast(vehicle.FindComponent(AG0_RadarRecieverTransmitterComponent)));
+        m_aVehiclePositions.Insert(vector.Zero);
+        m_aVehicleVelocities.Insert(vector.Zero);
+        m_aVehicleSampleTimes.Insert(0);
+        m_aVehicleCrossSections.Insert(ResolveCrossSection(vehicle));
     }
     
     //------------------------------------------------------------------------------------------------
-    protected void NotifyDetectedEntity(IEntity entity, float angle, float strength, int key)
+    //! Cross-section of the vehicle's prefab from its AG0_RadarCrossSectionComponent, medium (baseline strength) without one.
+    //! Looked up once per prefab; entities without prefab data are resolved every time they register.
+    protected ERadarCrossSection ResolveCrossSection(IEntity vehicle)
     {
-		Print("Notifying detected entity: " + entity.GetName() + " (Angle: " + angle + ", Strength: " + strength + ")");
-        AG0_RadarRecieverTransmitterComponent radarComp = AG0_RadarRecieverTransmitterComponent.Cast(entity.FindComponent(AG0_RadarRecieverTransmitterComponent));
-        if (radarComp && radarComp.CanDetect())
+        ResourceName prefab;
+        EntityPrefabData prefabData = vehicle.GetPrefabData();
+        if (prefabData)
+            prefab = prefabData.GetPrefabName();
+        
+        ERadarCrossSection crossSection;
+        if (!prefab.IsEmpty() && m_mPrefabCrossSections.Find(prefab, crossSection))
+            return crossSection;
+        
+        crossSection = ERadarCrossSection.MEDIUM;
+        AG0_RadarCrossSectionComponent crossSectionComponent = AG0_RadarCrossSectionComponent.Cast(vehicle.FindComponent(AG0_RadarCrossSectionComponent));
+        if (crossSectionComponent)
+            crossSection = crossSectionComponent.GetCrossSection();
+        
+        if (!prefab.IsEmpty())
+            m_mPrefabCrossSections.Insert(prefab, crossSection);
+        
+        return crossSection;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Only clears the slot so indices handed out this tick stay valid; the list is compacted on the next tick
+    void UnregisterVehicle(IEntity vehicle)
+    {
+        int index = m_aVehicles.Find(vehicle);
+        if (index < 0)
+            return;
+        
+        m_aVehicles[index] = null;
+        m_aVehicleEditables[index] = null;
+        m_aVehicleReceivers[index] = null;
+        m_bVehicleListDirty = true;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! Drops cleared and deleted slots. Swap-removal keeps the parallel arrays aligned.
+    protected void CompactVehicleList()
+    {
+        for (int i = m_aVehicles.Count() - 1; i >= 0; i--)
         {
-            radarComp.SetPainted(true, angle, strength, key);
+            if (m_aVehicles[i])
+                continue;
+            
+            m_aVehicles.Remove(i);
+            m_aVehicleEditables.Remove(i);
+            m_aVehicleReceivers.Remove(i);
+            m_aVehiclePositions.Remove(i);
+            m_aVehicleVelocities.Remove(i);
+            m_aVehicleSampleTimes.Remove(i);
+            m_aVehicleCrossSections.Remove(i);
         }
+        
+        m_bVehicleListDirty = false;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    //! receiver is the detected vehicle's cached radar component, null when it has none
+    protected void NotifyDetectedEntity(AG0_RadarRecieverTransmitterComponent receiver, AG0_RadarRecieverTransmitterComponent source, float angle, float strength)
+    {
+        if (!receiver || !receiver.CanDetect())
+            return;
+        
+#ifdef ENABLE_DIAG
+		if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.CONTACTS, LogLevel.DEBUG))
+		    AG0_RadarLog.Log(EAG0_RadarLogCategory.CONTACTS, "Notifying detected entity: " + receiver.GetOwner().GetName() + " (Angle: " + angle + ", Strength: " + strength + ")", LogLevel.DEBUG);
+#endif
+        receiver.Paint(source, angle, strength);
+        m_Stats.Add(EAG0_RadarStat.NOTIFICATIONS);
     }
 }
\ No newline at end of file
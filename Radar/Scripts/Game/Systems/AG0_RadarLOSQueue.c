@@ -0,0 +1,197 @@
+//! Line of sight requests of one coverage frame, merged so every unique segment is traced only once.
+//! Both ends of a request are quantized to cells; requests whose cells match, in either direction, share one trace.
+//! That covers radars that see each other (A to B and B to A) and co-located radars looking at the same target.
+//! Requests carry an opaque tag, the coverage system uses the pair index.
+//!
+//! Matching pairs mostly fall into different frames of a cycle, so resolved segments are also kept until BeginCycle;
+//! FindCycleResult answers a segment traced earlier in the cycle without queuing it again.
+class AG0_RadarLOSQueue
+{
+    protected float m_fInvCellSize = 0.5;
+
+    // Unique traces
+    protected ref array<vector> m_aStarts = {};
+    protected ref array<vector> m_aEnds = {};
+    protected ref array<AG0_RadarRecieverTransmitterComponent> m_aTracers = {};
+    protected ref array<IEntity> m_aTargets = {};
+    protected ref array<bool> m_aResults = {};
+    protected ref array<int> m_aCells = {};     // Canonical quantized ends, CELL_STRIDE ints per trace
+    protected ref map<int, int> m_mTraceByHash = new map<int, int>();
+
+    // Requests
+    protected ref array<int> m_aRequestTags = {};
+    protected ref array<int> m_aRequestTraces = {};
+
+    // Segments resolved so far in the current coverage cycle
+    protected ref array<bool> m_aCycleResults = {};
+    protected ref array<int> m_aCycleCells = {};    // CELL_STRIDE ints per segment
+    protected ref map<int, int> m_mCycleByHash = new map<int, int>();
+
+    // Canonical quantized ends written by Quantize
+    protected ref array<int> m_aKey = {0, 0, 0, 0, 0, 0};
+
+    protected static const int CELL_STRIDE = 6;
+
+    //------------------------------------------------------------------------------------------------
+    void SetCellSize(float cellSize)
+    {
+        m_fInvCellSize = 1 / Math.Max(cellSize, 0.01);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Drops the requests of the last frame; results of the cycle are kept
+    void Clear()
+    {
+        m_aStarts.Clear();
+        m_aEnds.Clear();
+        m_aTracers.Clear();
+        m_aTargets.Clear();
+        m_aResults.Clear();
+        m_aCells.Clear();
+        m_mTraceByHash.Clear();
+        m_aRequestTags.Clear();
+        m_aRequestTraces.Clear();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Forgets the segments resolved during the previous coverage cycle
+    void BeginCycle()
+    {
+        m_aCycleResults.Clear();
+        m_aCycleCells.Clear();
+        m_mCycleByHash.Clear();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! \return true when the same segment was already traced this cycle, clear then holds its result
+    bool FindCycleResult(vector start, vector end, out bool clear)
+    {
+        int hash = Quantize(start, end);
+
+        int segment;
+        if (!m_mCycleByHash.Find(hash, segment) || !MatchesKey(m_aCycleCells, segment * CELL_STRIDE))
+            return false;
+
+        clear = m_aCycleResults[segment];
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! \return true when the request needs a trace of its own, false when it shares one already queued
+    bool Request(int tag, notnull AG0_RadarRecieverTransmitterComponent radar, IEntity target, vector start, vector end)
+    {
+        int hash = Quantize(start, end);
+
+        int traceIndex;
+        if (m_mTraceByHash.Find(hash, traceIndex) && MatchesKey(m_aCells, traceIndex * CELL_STRIDE))
+        {
+            m_aRequestTags.Insert(tag);
+            m_aRequestTraces.Insert(traceIndex);
+            return false;
+        }
+
+        // New segment; on a hash collision the newer segment simply is not shared
+        traceIndex = m_aStarts.Insert(start);
+        m_aEnds.Insert(end);
+        m_aTracers.Insert(radar);
+        m_aTargets.Insert(target);
+        m_aResults.Insert(false);
+        m_aCells.InsertAll(m_aKey);
+
+        if (!m_mTraceByHash.Contains(hash))
+            m_mTraceByHash.Insert(hash, traceIndex);
+
+        m_aRequestTags.Insert(tag);
+        m_aRequestTraces.Insert(traceIndex);
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Issues every unique trace, each through the radar that requested it first, and keeps the results for the cycle
+    void Resolve()
+    {
+        foreach (int i, AG0_RadarRecieverTransmitterComponent tracer : m_aTracers)
+        {
+            if (!tracer)
+                continue;
+
+            bool clear = tracer.TraceLineOfSight(m_aTargets[i], m_aStarts[i], m_aEnds[i]);
+            m_aResults[i] = clear;
+
+            // Same rule as within a frame: on a hash collision the earlier segment keeps the slot
+            int hash = Quantize(m_aStarts[i], m_aEnds[i]);
+            if (m_mCycleByHash.Contains(hash))
+                continue;
+
+            m_mCycleByHash.Insert(hash, m_aCycleResults.Insert(clear));
+            m_aCycleCells.InsertAll(m_aKey);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetTraceCount()
+    {
+        return m_aStarts.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetRequestCount()
+    {
+        return m_aRequestTags.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetRequestTag(int request)
+    {
+        return m_aRequestTags[request];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Only valid after Resolve
+    bool IsRequestClear(int request)
+    {
+        return m_aResults[m_aRequestTraces[request]];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Quantizes both ends into m_aKey, ordered so A to B and B to A produce the same key, and returns its hash
+    protected int Quantize(vector start, vector end)
+    {
+        int sx = Math.Floor(start[0] * m_fInvCellSize);
+        int sy = Math.Floor(start[1] * m_fInvCellSize);
+        int sz = Math.Floor(start[2] * m_fInvCellSize);
+        int ex = Math.Floor(end[0] * m_fInvCellSize);
+        int ey = Math.Floor(end[1] * m_fInvCellSize);
+        int ez = Math.Floor(end[2] * m_fInvCellSize);
+
+        if (sx > ex || (sx == ex && (sy > ey || (sy == ey && sz > ez))))
+        {
+            int swap = sx; sx = ex; ex = swap;
+            swap = sy; sy = ey; ey = swap;
+            swap = sz; sz = ez; ez = swap;
+        }
+
+        m_aKey[0] = sx;
+        m_aKey[1] = sy;
+        m_aKey[2] = sz;
+        m_aKey[3] = ex;
+        m_aKey[4] = ey;
+        m_aKey[5] = ez;
+
+        int hash = (sx * 73856093) ^ (sy * 19349663) ^ (sz * 83492791);
+        return hash * 31 + ((ex * 73856093) ^ (ey * 19349663) ^ (ez * 83492791));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! True when the CELL_STRIDE ints of cells starting at offset equal m_aKey
+    protected bool MatchesKey(notnull array<int> cells, int offset)
+    {
+        for (int cell = 0; cell < CELL_STRIDE; cell++)
+        {
+            if (cells[offset + cell] != m_aKey[cell])
+                return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,138 @@
+//! Log categories of the radar mod, combinable as a mask
+enum EAG0_RadarLogCategory
+{
+    SYSTEM   = 1,   // Lifecycle, configuration and emitter state changes
+    COVERAGE = 2,   // Coverage cycles and per-pair culling
+    LOS      = 4,   // Line of sight traces
+    CONTACTS = 8,   // Contact creation, updates and notifications
+    PAINTING = 16   // RWR painting of receivers
+}
+
+modded enum SCR_DebugMenuID
+{
+    AG0_RADAR_MENU,
+    AG0_RADAR_LOG_SYSTEM,
+    AG0_RADAR_LOG_COVERAGE,
+    AG0_RADAR_LOG_LOS,
+    AG0_RADAR_LOG_CONTACTS,
+    AG0_RADAR_LOG_PAINTING,
+    AG0_RADAR_LOG_LEVEL,
+    AG0_RADAR_SHOW_STATS
+}
+
+//! Levelled, per-category logging for the radar hot paths.
+//! Every call site is wrapped in #ifdef ENABLE_DIAG so release builds never build the message strings:
+//!
+//!     #ifdef ENABLE_DIAG
+//!     if (AG0_RadarLog.IsEnabled(EAG0_RadarLogCategory.LOS, LogLevel.SPAM))
+//!         AG0_RadarLog.Log(EAG0_RadarLogCategory.LOS, "Trace result: " + traceScale, LogLevel.SPAM);
+//!     #endif
+//!
+//! In diag builds categories and the minimum level can be switched at runtime from the Radar diag menu. The menu is polled
+//! independently of any system tick and only applies values the user actually changed, so script calls to
+//! SetCategoryEnabled and SetMinLevel stay in effect until the matching menu entry is touched.
+//! Warnings and errors that indicate misconfiguration are printed directly and are not routed through here.
+class AG0_RadarLog
+{
+    protected static int s_iEnabledCategories = EAG0_RadarLogCategory.SYSTEM;
+    protected static LogLevel s_eMinLevel = LogLevel.NORMAL;
+
+#ifdef ENABLE_DIAG
+    protected static int s_iMenuCategories = EAG0_RadarLogCategory.SYSTEM;    // Menu state as last applied
+    protected static int s_iMenuMinLevel = LogLevel.NORMAL;
+    protected static const int MENU_POLL_INTERVAL_MS = 250;
+#endif
+
+    //------------------------------------------------------------------------------------------------
+    static bool IsEnabled(EAG0_RadarLogCategory category, LogLevel level)
+    {
+        return (s_iEnabledCategories & category) != 0 && level >= s_eMinLevel;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static void Log(EAG0_RadarLogCategory category, string message, LogLevel level = LogLevel.DEBUG)
+    {
+        Print("[Radar:" + typename.EnumToString(EAG0_RadarLogCategory, category) + "] " + message, level);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static void SetCategoryEnabled(EAG0_RadarLogCategory category, bool enabled)
+    {
+        if (enabled)
+            s_iEnabledCategories |= category;
+        else
+            s_iEnabledCategories &= ~category;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static void SetMinLevel(LogLevel level)
+    {
+        s_eMinLevel = level;
+    }
+
+#ifdef ENABLE_DIAG
+    //------------------------------------------------------------------------------------------------
+    static void RegisterDiagMenu()
+    {
+        DiagMenu.RegisterMenu(SCR_DebugMenuID.AG0_RADAR_MENU, "Radar", "Game");
+        DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_LOG_SYSTEM, "", "Log system", "Radar");
+        DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_LOG_COVERAGE, "", "Log coverage", "Radar");
+        DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_LOG_LOS, "", "Log line of sight", "Radar");
+        DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_LOG_CONTACTS, "", "Log contacts", "Radar");
+        DiagMenu.RegisterBool(SCR_DebugMenuID.AG0_RADAR_LOG_PAINTING, "", "Log painting", "Radar");
+        DiagMenu.RegisterRange(SCR_DebugMenuID.AG0_RADAR_LOG_LEVEL, "", "Log min level (0 spam - 3 normal)", "Radar", "0,3,3,1");
+
+        DiagMenu.SetValue(SCR_DebugMenuID.AG0_RADAR_LOG_SYSTEM, 1);
+        s_iMenuCategories = EAG0_RadarLogCategory.SYSTEM;
+        s_iMenuMinLevel = DiagMenu.GetRangeValue(SCR_DebugMenuID.AG0_RADAR_LOG_LEVEL);
+
+        GetGame().GetCallqueue().CallLater(SyncDiagMenu, MENU_POLL_INTERVAL_MS, true);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    static void UnregisterDiagMenu()
+    {
+        GetGame().GetCallqueue().Remove(SyncDiagMenu);
+
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_SYSTEM);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_COVERAGE);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_LOS);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_CONTACTS);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_PAINTING);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_LOG_LEVEL);
+        DiagMenu.Unregister(SCR_DebugMenuID.AG0_RADAR_MENU);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Applies the diag menu entries that changed since the last poll to the static filter
+    protected static void SyncDiagMenu()
+    {
+        int menuCategories;
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_LOG_SYSTEM))
+            menuCategories |= EAG0_RadarLogCategory.SYSTEM;
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_LOG_COVERAGE))
+            menuCategories |= EAG0_RadarLogCategory.COVERAGE;
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_LOG_LOS))
+            menuCategories |= EAG0_RadarLogCategory.LOS;
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_LOG_CONTACTS))
+            menuCategories |= EAG0_RadarLogCategory.CONTACTS;
+        if (DiagMenu.GetBool(SCR_DebugMenuID.AG0_RADAR_LOG_PAINTING))
+            menuCategories |= EAG0_RadarLogCategory.PAINTING;
+
+        // Only the toggled categories follow the menu
+        int changed = menuCategories ^ s_iMenuCategories;
+        if (changed != 0)
+        {
+            s_iEnabledCategories = (s_iEnabledCategories & ~changed) | (menuCategories & changed);
+            s_iMenuCategories = menuCategories;
+        }
+
+        int minLevel = DiagMenu.GetRangeValue(SCR_DebugMenuID.AG0_RADAR_LOG_LEVEL);
+        if (minLevel != s_iMenuMinLevel)
+        {
+            SetMinLevel(minLevel);
+            s_iMenuMinLevel = minLevel;
+        }
+    }
+#endif
+}
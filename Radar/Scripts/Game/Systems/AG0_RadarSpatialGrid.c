@@ -0,0 +1,142 @@
+//! Uniform 2D hash grid over world X/Z used by AG0_RadarCoverageSystem to find vehicles near a radar.
+//! Entries are plain indices into the caller's own arrays so the grid never holds entity references.
+class AG0_RadarSpatialGrid
+{
+    protected float m_fCellSize;
+    protected float m_fInvCellSize;
+
+    // Packed cell key -> indices binned into that cell
+    protected ref map<int, ref array<int>> m_mCells = new map<int, ref array<int>>();
+
+    // Cells that received at least one entry since the last Clear(), so Clear() does not walk the whole map
+    protected ref array<int> m_aOccupiedKeys = {};
+    protected ref array<float> m_aOccupiedCenters = {}; // X,Z pairs matching m_aOccupiedKeys
+    protected int m_iEntryCount;
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarSpatialGrid(float cellSize)
+    {
+        SetCellSize(cellSize);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void SetCellSize(float cellSize)
+    {
+        m_fCellSize = Math.Max(cellSize, 1.0);
+        m_fInvCellSize = 1.0 / m_fCellSize;
+        m_mCells.Clear();
+        m_aOccupiedKeys.Clear();
+        m_aOccupiedCenters.Clear();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    float GetCellSize()
+    {
+        return m_fCellSize;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Empties every cell but keeps the cell arrays allocated for the next rebuild
+    void Clear()
+    {
+        array<int> cell;
+        foreach (int key : m_aOccupiedKeys)
+        {
+            if (m_mCells.Find(key, cell))
+                cell.Clear();
+        }
+
+        m_aOccupiedKeys.Clear();
+        m_aOccupiedCenters.Clear();
+        m_iEntryCount = 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetEntryCount()
+    {
+        return m_iEntryCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void Insert(int index, vector position)
+    {
+        int cellX = Math.Floor(position[0] * m_fInvCellSize);
+        int cellZ = Math.Floor(position[2] * m_fInvCellSize);
+        int key = PackKey(cellX, cellZ);
+
+        array<int> cell;
+        if (!m_mCells.Find(key, cell))
+        {
+            cell = {};
+            m_mCells.Insert(key, cell);
+        }
+
+        if (cell.IsEmpty())
+        {
+            m_aOccupiedKeys.Insert(key);
+            m_aOccupiedCenters.Insert((cellX + 0.5) * m_fCellSize);
+            m_aOccupiedCenters.Insert((cellZ + 0.5) * m_fCellSize);
+        }
+
+        cell.Insert(index);
+        m_iEntryCount++;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Appends the indices of every cell overlapping the circle (center, radius) on the X/Z plane.
+    //! Results are a superset of the circle; callers still do the exact range check.
+    void Query(vector center, float radius, notnull array<int> outIndices)
+    {
+        if (m_aOccupiedKeys.IsEmpty())
+            return;
+
+        int minX = Math.Floor((center[0] - radius) * m_fInvCellSize);
+        int maxX = Math.Floor((center[0] + radius) * m_fInvCellSize);
+        int minZ = Math.Floor((center[2] - radius) * m_fInvCellSize);
+        int maxZ = Math.Floor((center[2] + radius) * m_fInvCellSize);
+
+        // Pad by half a cell diagonal so the cell-center test never rejects a cell the circle touches
+        float halfDiagonal = m_fCellSize * 0.7072;
+        float reachSq = (radius + halfDiagonal) * (radius + halfDiagonal);
+
+        array<int> cell;
+        float dx, dz;
+        int cellsInBox = (maxX - minX + 1) * (maxZ - minZ + 1);
+
+        // Long range radars cover far more cells than are occupied; walk the occupied list instead
+        if (cellsInBox > m_aOccupiedKeys.Count())
+        {
+            for (int i = 0, count = m_aOccupiedKeys.Count(); i < count; i++)
+            {
+                dx = m_aOccupiedCenters[i * 2] - center[0];
+                dz = m_aOccupiedCenters[i * 2 + 1] - center[2];
+                if (dx * dx + dz * dz > reachSq)
+                    continue;
+
+                if (m_mCells.Find(m_aOccupiedKeys[i], cell))
+                    outIndices.InsertAll(cell);
+            }
+            return;
+        }
+
+        for (int x = minX; x <= maxX; x++)
+        {
+            dx = (x + 0.5) * m_fCellSize - center[0];
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                dz = (z + 0.5) * m_fCellSize - center[2];
+                if (dx * dx + dz * dz > reachSq)
+                    continue;
+
+                if (m_mCells.Find(PackKey(x, z), cell))
+                    outIndices.InsertAll(cell);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected static int PackKey(int cellX, int cellZ)
+    {
+        return ((cellX & 0xFFFF) << 16) | (cellZ & 0xFFFF);
+    }
+}
@@ -0,0 +1,143 @@
+//! Fused track picture of every radar sharing one IFF key that uses the network picture, owned by AG0_RadarCoverageSystem.
+//! Each detected entity has exactly one track however many radars of the network see it, so memory and upkeep scale
+//! with the number of targets rather than targets times radars. Within one coverage cycle the measurement from the
+//! closest radar wins, since it is the most accurate one; the next cycle's first measurement replaces it.
+class AG0_RadarTrackPicture
+{
+    protected int m_iIFFKey;
+    protected ref array<ref AG0_RadarNetworkTrack> m_aTracks = {};
+    protected ref map<IEntity, AG0_RadarNetworkTrack> m_mByEntity = new map<IEntity, AG0_RadarNetworkTrack>();
+    protected int m_iGeneration;
+
+    static const float TRACK_MEMORY_TIME = 30.0;   // Seconds a track survives without any radar of the network seeing it
+
+    //------------------------------------------------------------------------------------------------
+    void AG0_RadarTrackPicture(int iffKey)
+    {
+        m_iIFFKey = iffKey;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Adds one radar's detection; range is the distance from that radar and decides which measurement is kept
+    void Contribute(IEntity entity, vector worldPosition, float range, AG0_RadarRecieverTransmitterComponent radar, float currentTime, int cycle)
+    {
+        AG0_RadarNetworkTrack track = m_mByEntity.Get(entity);
+        if (!track)
+        {
+            track = new AG0_RadarNetworkTrack();
+            track.m_Entity = entity;
+            track.m_fFirstDetectedTime = currentTime;
+            track.m_iIndex = m_aTracks.Insert(track);
+            m_mByEntity.Insert(entity, track);
+        }
+        else if (track.m_iCycle == cycle)
+        {
+            track.m_iContributors++;
+            if (range >= track.m_fRange)
+                return; // A closer radar already measured it this cycle
+        }
+        else
+        {
+            track.m_iContributors = 1;
+        }
+
+        track.m_vPosition = worldPosition;
+        track.m_fRange = range;
+        track.m_fLastDetectedTime = currentTime;
+        track.m_BestRadar = radar;
+        track.m_iCycle = cycle;
+        if (track.m_iContributors == 0)
+            track.m_iContributors = 1;
+
+        m_iGeneration++;
+        track.m_iGeneration = m_iGeneration;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Drops tracks no radar has seen for TRACK_MEMORY_TIME, or whose entity was deleted
+    void ExpireTracks(float currentTime)
+    {
+        for (int i = m_aTracks.Count() - 1; i >= 0; i--)
+        {
+            AG0_RadarNetworkTrack track = m_aTracks[i];
+            if (track.m_Entity && currentTime - track.m_fLastDetectedTime <= TRACK_MEMORY_TIME)
+                continue;
+
+            RemoveTrack(track);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    AG0_RadarNetworkTrack Find(IEntity entity)
+    {
+        return m_mByEntity.Get(entity);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Unordered, do not modify
+    array<ref AG0_RadarNetworkTrack> GetTracks()
+    {
+        return m_aTracks;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int Count()
+    {
+        return m_aTracks.Count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetIFFKey()
+    {
+        return m_iIFFKey;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Changes whenever a track is added, moved or dropped
+    int GetGeneration()
+    {
+        return m_iGeneration;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void RemoveTrack(AG0_RadarNetworkTrack track)
+    {
+        if (track.m_Entity)
+        {
+            m_mByEntity.Remove(track.m_Entity);
+        }
+        else
+        {
+            for (int i = m_mByEntity.Count() - 1; i >= 0; i--)
+            {
+                if (!m_mByEntity.GetKey(i))
+                    m_mByEntity.RemoveElement(i);
+            }
+        }
+
+        int index = track.m_iIndex;
+        int last = m_aTracks.Count() - 1;
+        if (index != last)
+        {
+            m_aTracks[index] = m_aTracks[last];
+            m_aTracks[index].m_iIndex = index;
+        }
+
+        m_aTracks.Remove(last);
+        m_iGeneration++;
+    }
+}
+
+class AG0_RadarNetworkTrack
+{
+    IEntity m_Entity;
+    vector m_vPosition;                                 // World position of the kept measurement
+    float m_fRange;                                     // Distance from m_BestRadar at that measurement
+    float m_fFirstDetectedTime;
+    float m_fLastDetectedTime;
+    AG0_RadarRecieverTransmitterComponent m_BestRadar;  // Radar whose measurement is kept
+    int m_iContributors;                                // Detections fused in m_iCycle
+    int m_iCycle = -1;                                  // Coverage cycle of the kept measurement
+    int m_iGeneration;                                  // Picture generation of the last change
+    int m_iIndex = -1;
+}
@@ -0,0 +1,107 @@
+//! Vehicle info display showing the contacts of the vehicle's radar on RadarContacts.layout.
+//! Remote crew draw the replicated contact picture; the server or a listen server host draws the contact store directly.
+class AG0_RadarScopeDisplay : SCR_InfoDisplayExtended
+{
+    [Attribute("{C41F7A9D2E6B8035}UI/layouts/RadarContactBlip.layout", UIWidgets.ResourceNamePicker, "Layout of a single contact blip", "layout")]
+    protected ResourceName m_sBlipLayout;
+
+    [Attribute("Blips", desc: "Name of the frame the blips are placed in; its center is the radar")]
+    protected string m_sBlipFrameName;
+
+    [Attribute("360", UIWidgets.EditBox, "Radius of the scope in layout units")]
+    protected float m_fScopeRadius;
+
+    protected AG0_RadarRecieverTransmitterComponent m_Radar;
+    protected ref AG0_RadarScopeRenderer m_Renderer;
+    protected ref array<AG0_RadarReplicatedContact> m_aReplicatedContacts = {};
+    protected bool m_bDrawingReplicated;
+
+    //------------------------------------------------------------------------------------------------
+    override void DisplayStartDraw(IEntity owner)
+    {
+        super.DisplayStartDraw(owner);
+
+        if (!m_wRoot)
+            return;
+
+        m_Radar = AG0_RadarRecieverTransmitterComponent.Cast(owner.FindComponent(AG0_RadarRecieverTransmitterComponent));
+
+        Widget blipFrame = m_wRoot.FindAnyWidget(m_sBlipFrameName);
+        if (!blipFrame)
+        {
+            Print("AG0_RadarScopeDisplay: blip frame '" + m_sBlipFrameName + "' not found in layout", LogLevel.WARNING);
+            return;
+        }
+
+        m_Renderer = new AG0_RadarScopeRenderer(blipFrame, m_sBlipLayout, m_fScopeRadius);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    override void DisplayStopDraw(IEntity owner)
+    {
+        if (m_Renderer)
+            m_Renderer.Clear();
+
+        m_Renderer = null;
+        m_Radar = null;
+
+        super.DisplayStopDraw(owner);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    override void DisplayUpdate(IEntity owner, float timeSlice)
+    {
+        if (!m_Renderer || !m_Radar)
+            return;
+
+        m_Renderer.SetRange(m_Radar.GetMaxRange());
+
+        AG0_RadarContactPicture picture = m_Radar.GetReplicatedContacts();
+        if (picture)
+            DrawReplicated(picture);
+        else
+            DrawLocal();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void DrawReplicated(AG0_RadarContactPicture picture)
+    {
+        if (!m_bDrawingReplicated)
+        {
+            m_bDrawingReplicated = true;
+            m_Renderer.Invalidate();
+        }
+
+        if (!m_Renderer.BeginUpdate(picture.GetGeneration()))
+            return;
+
+        picture.GetContacts(m_aReplicatedContacts);
+        foreach (AG0_RadarReplicatedContact contact : m_aReplicatedContacts)
+        {
+            m_Renderer.SetBlip(contact.m_iTrackId, contact.m_iGeneration, contact.m_fAzimuth, contact.m_fRange);
+        }
+
+        m_Renderer.EndUpdate();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected void DrawLocal()
+    {
+        if (m_bDrawingReplicated)
+        {
+            m_bDrawingReplicated = false;
+            m_Renderer.Invalidate();
+        }
+
+        int generation = m_Radar.GetContactGeneration();
+        if (generation < 0 || !m_Renderer.BeginUpdate(generation))
+            return;
+
+        foreach (RadarContact contact : m_Radar.GetDisplayableContacts())
+        {
+            m_Renderer.SetBlip(contact.m_iTrackId, contact.m_iGeneration, contact.GetAzimuth(), contact.GetDistance());
+        }
+
+        m_Renderer.EndUpdate();
+    }
+}
@@ -0,0 +1,158 @@
+//! Retained-mode plan position scope: one pooled blip widget per contact, forward up, range growing outwards.
+//! Callers feed it contacts between BeginUpdate and EndUpdate. BeginUpdate returns false when the source generation did not
+//! change, so an idle scope costs one int compare per frame. Within an update only blips whose contact generation changed
+//! are moved, blips of vanished contacts are hidden and returned to the pool instead of being destroyed.
+class AG0_RadarScopeRenderer
+{
+    protected Widget m_wBlipParent;
+    protected ResourceName m_sBlipLayout;
+    protected float m_fScopeRadius;
+    protected float m_fRange = 1;
+
+    protected ref map<int, ref AG0_RadarScopeBlip> m_mBlips = new map<int, ref AG0_RadarScopeBlip>();
+    protected ref array<ref AG0_RadarScopeBlip> m_aFreeBlips = {};
+    protected int m_iBlipCount;
+    protected int m_iLastGeneration = -1;
+    protected int m_iRound;
+
+    static const int MAX_BLIPS = 256;
+
+    //------------------------------------------------------------------------------------------------
+    //! scopeRadius in layout units of blipParent, whose center is the radar
+    void AG0_RadarScopeRenderer(notnull Widget blipParent, ResourceName blipLayout, float scopeRadius)
+    {
+        m_wBlipParent = blipParent;
+        m_sBlipLayout = blipLayout;
+        m_fScopeRadius = scopeRadius;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Range at the edge of the scope; repositions every blip on the next update when it changes
+    void SetRange(float range)
+    {
+        if (range <= 0 || range == m_fRange)
+            return;
+
+        m_fRange = range;
+        Invalidate();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Forces the next update through, e.g. after switching to another contact source
+    void Invalidate()
+    {
+        m_iLastGeneration = -1;
+        for (int i = 0; i < m_mBlips.Count(); i++)
+        {
+            m_mBlips.GetElement(i).m_iGeneration = -1;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool BeginUpdate(int generation)
+    {
+        if (generation == m_iLastGeneration)
+            return false;
+
+        m_iLastGeneration = generation;
+        m_iRound++;
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! azimuth in degrees clockwise from the radar's forward, range in meters
+    void SetBlip(int trackId, int generation, float azimuth, float range)
+    {
+        AG0_RadarScopeBlip blip = m_mBlips.Get(trackId);
+        if (!blip)
+        {
+            blip = AcquireBlip();
+            if (!blip)
+                return;
+
+            m_mBlips.Insert(trackId, blip);
+        }
+
+        blip.m_iRound = m_iRound;
+        if (blip.m_iGeneration == generation)
+            return;
+
+        blip.m_iGeneration = generation;
+
+        float radius = Math.Min(range / m_fRange, 1) * m_fScopeRadius;
+        float angle = azimuth * Math.DEG2RAD;
+        FrameSlot.SetPos(blip.m_wWidget, m_fScopeRadius + Math.Sin(angle) * radius, m_fScopeRadius - Math.Cos(angle) * radius);
+        blip.m_wWidget.SetVisible(true);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Releases the blips of contacts that were not fed since BeginUpdate
+    void EndUpdate()
+    {
+        for (int i = m_mBlips.Count() - 1; i >= 0; i--)
+        {
+            AG0_RadarScopeBlip blip = m_mBlips.GetElement(i);
+            if (blip.m_iRound == m_iRound)
+                continue;
+
+            blip.m_wWidget.SetVisible(false);
+            m_aFreeBlips.Insert(blip);
+            m_mBlips.RemoveElement(i);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    //! Destroys every blip widget, pooled or not
+    void Clear()
+    {
+        for (int i = 0; i < m_mBlips.Count(); i++)
+        {
+            m_aFreeBlips.Insert(m_mBlips.GetElement(i));
+        }
+
+        foreach (AG0_RadarScopeBlip blip : m_aFreeBlips)
+        {
+            if (blip.m_wWidget)
+                blip.m_wWidget.RemoveFromHierarchy();
+        }
+
+        m_mBlips.Clear();
+        m_aFreeBlips.Clear();
+        m_iBlipCount = 0;
+        m_iLastGeneration = -1;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    protected AG0_RadarScopeBlip AcquireBlip()
+    {
+        AG0_RadarScopeBlip blip;
+        int freeCount = m_aFreeBlips.Count();
+        if (freeCount > 0)
+        {
+            blip = m_aFreeBlips[freeCount - 1];
+            m_aFreeBlips.Remove(freeCount - 1);
+            blip.m_iGeneration = -1;
+            return blip;
+        }
+
+        if (m_iBlipCount >= MAX_BLIPS)
+            return null;
+
+        Widget widget = GetGame().GetWorkspace().CreateWidgets(m_sBlipLayout, m_wBlipParent);
+        if (!widget)
+            return null;
+
+        m_iBlipCount++;
+        blip = new AG0_RadarScopeBlip();
+        blip.m_wWidget = widget;
+        blip.m_iGeneration = -1;
+        return blip;
+    }
+}
+
+class AG0_RadarScopeBlip
+{
+    Widget m_wWidget;
+    int m_iGeneration;      // Contact generation the widget currently shows
+    int m_iRound;           // Renderer update the contact was last fed in
+}